@@ -62,13 +62,13 @@ struct Node;
 
 struct Pin
 {
-    int         ID;
+    ed::ObjectId ID;
     Node*       Node;
     std::string Name;
     PinType     Type;
     PinKind     Kind;
 
-    Pin(int id, const char* name, PinType type):
+    Pin(ed::ObjectId id, const char* name, PinType type):
         ID(id), Node(nullptr), Name(name), Type(type), Kind(PinKind::Target)
     {
     }
@@ -76,7 +76,7 @@ struct Pin
 
 struct Node
 {
-    int ID;
+    ed::ObjectId ID;
     std::string Name;
     std::vector<Pin> Inputs;
     std::vector<Pin> Outputs;
@@ -87,7 +87,7 @@ struct Node
     std::string State;
     std::string SavedState;
 
-    Node(int id, const char* name, ImColor color = ImColor(255, 255, 255)):
+    Node(ed::ObjectId id, const char* name, ImColor color = ImColor(255, 255, 255)):
         ID(id), Name(name), Color(color), Type(NodeType::Blueprint), Size(0, 0)
     {
     }
@@ -95,14 +95,14 @@ struct Node
 
 struct Link
 {
-    int ID;
+    ed::ObjectId ID;
 
-    int StartPinID;
-    int EndPinID;
+    ed::ObjectId StartPinID;
+    ed::ObjectId EndPinID;
 
     ImColor Color;
 
-    Link(int id, int startPinId, int endPinId):
+    Link(ed::ObjectId id, ed::ObjectId startPinId, ed::ObjectId endPinId):
         ID(id), StartPinID(startPinId), EndPinID(endPinId), Color(255, 255, 255)
     {
     }
@@ -118,20 +118,20 @@ static ImTextureID          s_SaveIcon = nullptr;
 static ImTextureID          s_RestoreIcon = nullptr;
 
 static const float          s_TouchTime = 1.0f;
-static std::map<int, float> s_NodeTouchTime;
+static std::map<ed::ObjectId, float> s_NodeTouchTime;
 
-static int s_NextId = 1;
-static int GetNextId()
+static ed::ObjectId s_NextId = 1;
+static ed::ObjectId GetNextId()
 {
     return s_NextId++;
 }
 
-static void TouchNode(int id)
+static void TouchNode(ed::ObjectId id)
 {
     s_NodeTouchTime[id] = s_TouchTime;
 }
 
-static float GetTouchProgress(int id)
+static float GetTouchProgress(ed::ObjectId id)
 {
     auto it = s_NodeTouchTime.find(id);
     if (it != s_NodeTouchTime.end() && it->second > 0.0f)
@@ -150,7 +150,7 @@ static void UpdateTouch()
     }
 }
 
-static Node* FindNode(int id)
+static Node* FindNode(ed::ObjectId id)
 {
     for (auto& node : s_Nodes)
         if (node.ID == id)
@@ -159,7 +159,7 @@ static Node* FindNode(int id)
     return nullptr;
 }
 
-static Link* FindLink(int id)
+static Link* FindLink(ed::ObjectId id)
 {
     for (auto& link : s_Links)
         if (link.ID == id)
@@ -168,7 +168,7 @@ static Link* FindLink(int id)
     return nullptr;
 }
 
-static Pin* FindPin(int id)
+static Pin* FindPin(ed::ObjectId id)
 {
     if (id <= 0)
         return nullptr;
@@ -187,7 +187,7 @@ static Pin* FindPin(int id)
     return nullptr;
 }
 
-static bool IsPinLinked(int id)
+static bool IsPinLinked(ed::ObjectId id)
 {
     if (id <= 0)
         return false;
@@ -402,7 +402,7 @@ void BuildNodes()
 void Application_Initialize()
 {
     ed::Config config;
-    config.LoadNodeSettings = [](int nodeId, char* data, void* userPointer) -> size_t
+    config.LoadNodeSettings = [](ed::ObjectId nodeId, char* data, void* userPointer) -> size_t
     {
         auto node = FindNode(nodeId);
         if (!node)
@@ -413,7 +413,7 @@ void Application_Initialize()
         return node->State.size();
     };
 
-    config.SaveNodeSettings = [](int nodeId, const char* data, size_t size, ed::SaveReasonFlags reason, void* userPointer) -> bool
+    config.SaveNodeSettings = [](ed::ObjectId nodeId, const char* data, size_t size, ed::SaveReasonFlags reason, void* userPointer) -> bool
     {
         auto node = FindNode(nodeId);
         if (!node)
@@ -650,7 +650,7 @@ void ShowLeftPane(float paneWidth)
     if (showStyleEditor)
         ShowStyleEditor(&showStyleEditor);
 
-    std::vector<int> selectedNodes, selectedLinks;
+    std::vector<ed::ObjectId> selectedNodes, selectedLinks;
     selectedNodes.resize(ed::GetSelectedObjectCount());
     selectedLinks.resize(ed::GetSelectedObjectCount());
 
@@ -781,8 +781,8 @@ void ShowLeftPane(float paneWidth)
         ed::ClearSelection();
     ImGui::EndHorizontal();
     ImGui::Indent();
-    for (int i = 0; i < nodeCount; ++i) ImGui::Text("Node (%d)", selectedNodes[i]);
-    for (int i = 0; i < linkCount; ++i) ImGui::Text("Link (%d)", selectedLinks[i]);
+    for (int i = 0; i < nodeCount; ++i) ImGui::Text("Node (%llu)", static_cast<unsigned long long>(selectedNodes[i]));
+    for (int i = 0; i < linkCount; ++i) ImGui::Text("Link (%llu)", static_cast<unsigned long long>(selectedLinks[i]));
     ImGui::Unindent();
 
     if (ImGui::IsKeyPressed(ImGui::GetKeyIndex(ImGuiKey_Z)))
@@ -807,10 +807,10 @@ void Application_Frame()
 
     auto& style = ImGui::GetStyle();
 
-    static int  contextId      = 0;
-    static bool createNewNode  = false;
-    static Pin* newNodeLinkPin = nullptr;
-    static Pin* newLinkPin     = nullptr;
+    static ed::ObjectId contextId      = 0;
+    static bool         createNewNode  = false;
+    static Pin*         newNodeLinkPin = nullptr;
+    static Pin*         newLinkPin     = nullptr;
 
     static float leftPaneWidth  = 400.0f;
     static float rightPaneWidth = 800.0f;
@@ -1163,7 +1163,7 @@ void Application_Frame()
                     ImGui::TextUnformatted(label);
                 };
 
-                int startPinId = 0, endPinId = 0;
+                ed::ObjectId startPinId = 0, endPinId = 0;
                 if (ed::QueryNewLink(&startPinId, &endPinId))
                 {
                     auto startPin = FindPin(startPinId);
@@ -1210,7 +1210,7 @@ void Application_Frame()
                     }
                 }
 
-                int pinId = 0;
+                ed::ObjectId pinId = 0;
                 if (ed::QueryNewNode(&pinId))
                 {
                     newLinkPin = FindPin(pinId);
@@ -1233,7 +1233,7 @@ void Application_Frame()
 
             if (ed::BeginDelete())
             {
-                int linkId = 0;
+                ed::ObjectId linkId = 0;
                 while (ed::QueryDeletedLink(&linkId))
                 {
                     if (ed::AcceptDeletedItem())
@@ -1244,7 +1244,7 @@ void Application_Frame()
                     }
                 }
 
-                int nodeId = 0;
+                ed::ObjectId nodeId = 0;
                 while (ed::QueryDeletedNode(&nodeId))
                 {
                     if (ed::AcceptDeletedItem())
@@ -1283,13 +1283,13 @@ void Application_Frame()
         ImGui::Separator();
         if (node)
         {
-            ImGui::Text("ID: %d", node->ID);
+            ImGui::Text("ID: %llu", static_cast<unsigned long long>(node->ID));
             ImGui::Text("Type: %s", node->Type == NodeType::Blueprint ? "Blueprint" : (node->Type == NodeType::Tree ? "Tree" : "Comment"));
             ImGui::Text("Inputs: %d", (int)node->Inputs.size());
             ImGui::Text("Outputs: %d", (int)node->Outputs.size());
         }
         else
-            ImGui::Text("Unknown node: %d", contextId);
+            ImGui::Text("Unknown node: %llu", static_cast<unsigned long long>(contextId));
         ImGui::Separator();
         if (ImGui::MenuItem("Delete"))
             ed::DeleteNode(contextId);
@@ -1304,14 +1304,14 @@ void Application_Frame()
         ImGui::Separator();
         if (pin)
         {
-            ImGui::Text("ID: %d", pin->ID);
+            ImGui::Text("ID: %llu", static_cast<unsigned long long>(pin->ID));
             if (pin->Node)
-                ImGui::Text("Node: %d", pin->Node->ID);
+                ImGui::Text("Node: %llu", static_cast<unsigned long long>(pin->Node->ID));
             else
                 ImGui::Text("Node: %s", "<none>");
         }
         else
-            ImGui::Text("Unknown pin: %d", contextId);
+            ImGui::Text("Unknown pin: %llu", static_cast<unsigned long long>(contextId));
 
         ImGui::EndPopup();
     }
@@ -1324,12 +1324,12 @@ void Application_Frame()
         ImGui::Separator();
         if (link)
         {
-            ImGui::Text("ID: %d", link->ID);
-            ImGui::Text("From: %d", link->StartPinID);
-            ImGui::Text("To: %d", link->EndPinID);
+            ImGui::Text("ID: %llu", static_cast<unsigned long long>(link->ID));
+            ImGui::Text("From: %llu", static_cast<unsigned long long>(link->StartPinID));
+            ImGui::Text("To: %llu", static_cast<unsigned long long>(link->EndPinID));
         }
         else
-            ImGui::Text("Unknown link: %d", contextId);
+            ImGui::Text("Unknown link: %llu", static_cast<unsigned long long>(contextId));
         ImGui::Separator();
         if (ImGui::MenuItem("Delete"))
             ed::DeleteLink(contextId);
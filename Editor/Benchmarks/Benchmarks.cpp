@@ -0,0 +1,436 @@
+//------------------------------------------------------------------------------
+// LICENSE
+//   This software is dual-licensed to the public domain and under the following
+//   license: you are granted a perpetual, irrevocable license to copy, modify,
+//   publish, and distribute this file as you see fit.
+//
+// CREDITS
+//   Written by Michal Cichon
+//------------------------------------------------------------------------------
+# include "Editor/NodeEditor/NodeEditorImpl.h"
+# include <chrono>
+# include <random>
+# include <memory>
+# include <cmath>
+# include <cstdio>
+
+
+//------------------------------------------------------------------------------
+namespace ed = ax::NodeEditor::Detail;
+namespace ne = ax::NodeEditor;
+
+
+//------------------------------------------------------------------------------
+// Returns best time of a run in milliseconds, best is least disturbed by
+// other processes.
+template <typename F>
+static double Measure(int runCount, F&& run)
+{
+    auto best = HUGE_VAL;
+    for (int i = 0; i < runCount; ++i)
+    {
+        const auto start = std::chrono::high_resolution_clock::now();
+        run();
+        const auto stop  = std::chrono::high_resolution_clock::now();
+
+        best = std::min(best, std::chrono::duration<double, std::milli>(stop - start).count());
+    }
+
+    return best;
+}
+
+static void Report(const char* name, double milliseconds, double baseline = 0.0)
+{
+    if (baseline > 0.0)
+        printf("    %-44s %10.3f ms  (x%.2f)\n", name, milliseconds, baseline / milliseconds);
+    else
+        printf("    %-44s %10.3f ms\n", name, milliseconds);
+}
+
+// Keeps results alive, so optimizer cannot drop measured code.
+static volatile size_t s_Sink;
+
+
+
+
+//------------------------------------------------------------------------------
+//
+// Visibility culling
+//
+//------------------------------------------------------------------------------
+struct BenchmarkObject final: ed::Object
+{
+    ax::rectf Bounds;
+
+    BenchmarkObject(ed::ObjectId id, const ax::rectf& bounds):
+        Object(nullptr, ed::ObjectType::Node, id), Bounds(bounds)
+    {
+    }
+
+    virtual void Draw(ImDrawList* drawList, DrawFlags flags = None) override { }
+    virtual ax::rectf GetBounds() const override { return Bounds; }
+};
+
+static void BenchmarkCull(int objectCount)
+{
+    printf("Cull %d objects against visible area\n", objectCount);
+
+    const int frameIndex = 1;
+
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> position(0.0f, 100000.0f);
+    std::uniform_real_distribution<float> size(50.0f, 300.0f);
+
+    std::vector<std::unique_ptr<BenchmarkObject>> objects;
+    objects.reserve(objectCount);
+    for (int i = 0; i < objectCount; ++i)
+    {
+        objects.emplace_back(new BenchmarkObject(i + 1, ax::rectf(position(random), position(random), size(random), size(random))));
+        objects.back()->LiveFrame = frameIndex;
+    }
+
+    // Allocation order is not drawing order
+    std::vector<BenchmarkObject*> order;
+    for (auto& object : objects)
+        order.push_back(object.get());
+    std::shuffle(order.begin(), order.end(), random);
+
+    ed::VisibilitySet visibility;
+    for (auto object : order)
+        object->VisibilitySlot = visibility.Add(object, object->Bounds);
+
+    const ax::rectf views[] =
+    {
+        ax::rectf(40000.0f, 40000.0f,  1920.0f,  1080.0f),
+        ax::rectf(20000.0f, 20000.0f, 50000.0f, 30000.0f)
+    };
+
+    for (auto& view : views)
+    {
+        // Per object test of virtual bounds, same as ImGui::IsRectVisible
+        size_t visibleCount = 0;
+        const auto perObject = Measure(10, [&]()
+        {
+            visibleCount = 0;
+            for (auto object : order)
+            {
+                const auto bounds = static_cast<ed::Object*>(object)->GetBounds();
+                if (bounds.left() < view.right() && bounds.right() > view.left() && bounds.top() < view.bottom() && bounds.bottom() > view.top())
+                    ++visibleCount;
+            }
+            s_Sink = visibleCount;
+        });
+
+        const auto batched = Measure(10, [&]()
+        {
+            visibility.Cull(view, frameIndex);
+            s_Sink = visibility.GetVisibleObjects().size();
+        });
+
+        assert(visibility.GetVisibleObjects().size() == visibleCount);
+
+        printf("  %d visible\n", static_cast<int>(visibleCount));
+        Report("Object::GetBounds() per object", perObject);
+        Report("VisibilitySet::Cull()", batched, perObject);
+    }
+}
+
+
+
+
+//------------------------------------------------------------------------------
+//
+// Selection filtering
+//
+//------------------------------------------------------------------------------
+static void BenchmarkSelectionFilter(int objectCount)
+{
+    printf("Filter %d selected objects\n", objectCount);
+
+    std::mt19937 random(2);
+
+    std::vector<std::unique_ptr<ed::Object>> objects;
+    objects.reserve(objectCount);
+    for (int i = 0; i < objectCount; ++i)
+    {
+        const auto id = static_cast<ed::ObjectId>(i + 1);
+        switch (random() % 3)
+        {
+            case 0:  objects.emplace_back(new ed::Node(nullptr, id)); break;
+            case 1:  objects.emplace_back(new ed::Pin(nullptr, id, ne::PinKind::Source)); break;
+            default: objects.emplace_back(new ed::Link(nullptr, id)); break;
+        }
+    }
+
+    std::vector<ed::Object*> selection;
+    for (auto& object : objects)
+        selection.push_back(object.get());
+    std::shuffle(selection.begin(), selection.end(), random);
+
+    std::vector<ed::Object*> result;
+    result.reserve(selection.size());
+
+    const auto virtualCall = Measure(20, [&]()
+    {
+        result.clear();
+        for (auto object : selection)
+            if (object->IsSelectable())
+                result.push_back(object);
+        s_Sink = result.size();
+    });
+    const auto virtualCount = result.size();
+
+    const auto typeTag = Measure(20, [&]()
+    {
+        result.clear();
+        for (auto object : selection)
+            if (!object->IsPin())
+                result.push_back(object);
+        s_Sink = result.size();
+    });
+
+    assert(result.size() == virtualCount);
+
+    const auto dynamicCast = Measure(20, [&]()
+    {
+        result.clear();
+        for (auto object : selection)
+            if (dynamic_cast<ed::Node*>(object))
+                result.push_back(object);
+        s_Sink = result.size();
+    });
+
+    const auto asNode = Measure(20, [&]()
+    {
+        result.clear();
+        for (auto object : selection)
+            if (object->AsNode())
+                result.push_back(object);
+        s_Sink = result.size();
+    });
+
+    Report("Selectable by virtual IsSelectable()", virtualCall);
+    Report("Selectable by type tag", typeTag, virtualCall);
+    Report("Nodes by dynamic_cast", dynamicCast);
+    Report("Nodes by AsNode()", asNode, dynamicCast);
+}
+
+
+
+
+//------------------------------------------------------------------------------
+//
+// Vertex transformation
+//
+//------------------------------------------------------------------------------
+static void BenchmarkTransformedRects(int vertexCount)
+{
+    printf("Write %d vertices of filled rectangles\n", vertexCount);
+
+    const auto rectCount = vertexCount / 4;
+
+    ImDrawList drawList;
+
+    auto record = [&](const ImMatrix* transformation)
+    {
+        return Measure(10, [&]()
+        {
+            drawList.Clear();
+            drawList.PushClipRectFullScreen();
+            drawList.PushTextureID(ImGui::GetIO().Fonts->TexID);
+            if (transformation)
+                drawList.PushTransformation(*transformation);
+
+            for (int i = 0; i < rectCount; ++i)
+            {
+                const auto x = static_cast<float>(i % 1000) * 2.0f;
+                const auto y = static_cast<float>(i / 1000) * 2.0f;
+                drawList.AddRectFilled(ImVec2(x, y), ImVec2(x + 1.5f, y + 1.5f), IM_COL32_WHITE);
+            }
+
+            if (transformation)
+                drawList.PopTransformation();
+
+            s_Sink = drawList.VtxBuffer.Size;
+        });
+    };
+
+    const auto angle = 0.1f;
+
+    const auto scaleTranslate = ImMatrix(0.5f, 0.0f, 0.0f, 0.5f, 100.0f, 50.0f);
+    const auto rotation       = ImMatrix(0.5f * cosf(angle), 0.5f * sinf(angle), -0.5f * sinf(angle), 0.5f * cosf(angle), 100.0f, 50.0f);
+
+    const auto identity     = record(nullptr);
+    const auto axisAligned  = record(&scaleTranslate);
+    const auto fourCorners  = record(&rotation);
+
+    assert(drawList.VtxBuffer.Size == rectCount * 4);
+
+    Report("No transformation", identity);
+    Report("Rotated, four corners transformed", fourCorners);
+    Report("Scale and translate, two corners", axisAligned, fourCorners);
+
+    drawList.ClearFreeMemory();
+}
+
+
+
+
+//------------------------------------------------------------------------------
+//
+// Editor frame
+//
+//------------------------------------------------------------------------------
+static void SubmitGraph(int nodeCount, int columnCount)
+{
+    int id = 1;
+    for (int i = 0; i < nodeCount; ++i, id += 3)
+    {
+        ne::BeginNode(id);
+            ImGui::Text("Node %d", i);
+            ne::BeginPin(id + 1, ne::PinKind::Target);
+                ImGui::Text("-> In");
+            ne::EndPin();
+            ImGui::SameLine();
+            ne::BeginPin(id + 2, ne::PinKind::Source);
+                ImGui::Text("Out ->");
+            ne::EndPin();
+        ne::EndNode();
+    }
+
+    // Chain nodes in every row
+    for (int i = 1; i < nodeCount; ++i)
+    {
+        if (i % columnCount == 0)
+            continue;
+
+        const auto startPin = (i - 1) * 3 + 3;
+        const auto endPin   = i * 3 + 2;
+        ne::Link(nodeCount * 3 + i, startPin, endPin);
+    }
+}
+
+// Editor with its own copy of the graph, frames of several editors are
+// interleaved so they are equally affected by other processes.
+struct EditorFrameRunner
+{
+    ne::EditorContext*  Editor;
+    bool                Pan;
+    int                 FrameIndex;
+    std::vector<double> FrameTimes;
+
+    EditorFrameRunner(bool pan):
+        Editor(nullptr), Pan(pan), FrameIndex(0)
+    {
+        ne::Config config;
+        config.SettingsFile = nullptr;
+
+        Editor = ne::CreateEditor(&config);
+    }
+
+    ~EditorFrameRunner()
+    {
+        ne::DestroyEditor(Editor);
+    }
+
+    void Frame(int nodeCount, bool measure)
+    {
+        const auto columnCount = 100;
+
+        auto& io = ImGui::GetIO();
+
+        ne::SetCurrentEditor(Editor);
+
+        const auto start = std::chrono::high_resolution_clock::now();
+
+        ImGui::NewFrame();
+
+        // Moving host window moves every node on screen, while canvas stays the same
+        const auto offset = Pan ? static_cast<float>(FrameIndex % 64) : 0.0f;
+        ImGui::SetNextWindowPos(ImVec2(offset, offset));
+        ImGui::SetNextWindowSize(io.DisplaySize);
+        ImGui::Begin("Content", nullptr, ImVec2(0, 0), 0.0f,
+            ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove |
+            ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoScrollWithMouse | ImGuiWindowFlags_NoSavedSettings |
+            ImGuiWindowFlags_NoBringToFrontOnFocus);
+
+        ne::Begin("Benchmark");
+
+        SubmitGraph(nodeCount, columnCount);
+
+        if (FrameIndex == 0)
+        {
+            for (int i = 0; i < nodeCount; ++i)
+                ne::SetNodePosition(1 + i * 3, ImVec2(static_cast<float>(i % columnCount) * 160.0f, static_cast<float>(i / columnCount) * 100.0f));
+        }
+        else if (FrameIndex == 1)
+            ne::NavigateToContent(0.0f);
+
+        ne::End();
+
+        ImGui::End();
+        ImGui::Render();
+
+        const auto stop = std::chrono::high_resolution_clock::now();
+
+        if (measure)
+            FrameTimes.push_back(std::chrono::duration<double, std::milli>(stop - start).count());
+
+        ++FrameIndex;
+    }
+
+    void Report(const char* name)
+    {
+        std::sort(FrameTimes.begin(), FrameTimes.end());
+
+        printf("    %-44s %10.3f ms  median frame\n", name, FrameTimes[FrameTimes.size() / 2]);
+    }
+};
+
+static void BenchmarkEditorFrame(int nodeCount)
+{
+    printf("Editor frame with %d nodes, whole graph in view\n", nodeCount);
+
+    EditorFrameRunner staticFrame(false);
+    EditorFrameRunner pannedFrame(true);
+
+    EditorFrameRunner* runners[] = { &staticFrame, &pannedFrame };
+
+    // First frames let navigation settle
+    for (int i = 0; i < 200; ++i)
+        for (auto runner : runners)
+            runner->Frame(nodeCount, i >= 20);
+
+    staticFrame.Report("Static");
+    pannedFrame.Report("Panned");
+}
+
+
+
+
+//------------------------------------------------------------------------------
+int main()
+{
+    auto& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime   = 1.0f / 60.0f;
+    io.IniFilename = nullptr;
+
+    unsigned char* pixels = nullptr;
+    int width = 0, height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+    // Sets up white pixel and default font used by draw lists
+    ImGui::NewFrame();
+    ImGui::Render();
+
+    BenchmarkCull(1000000);
+    BenchmarkSelectionFilter(100000);
+    BenchmarkTransformedRects(1000000);
+    BenchmarkTransformedRects(5000000);
+    BenchmarkEditorFrame(5000);
+
+    ImGui::Shutdown();
+
+    return 0;
+}
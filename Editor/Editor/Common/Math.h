@@ -1008,6 +1008,238 @@ inline cubic_bezier_split_t cubic_bezier_split(const pointf& p0, const pointf& p
     };
 };
 
+namespace detail {
+// Narrows [t0, t1] to range in which cubic with Bernstein coefficients d may
+// be non-negative. Range comes from convex hull of control polygon, which is
+// crossed by zero line only between points of opposite sign. Range is empty
+// when t0 > t1. All L lanes are processed at once.
+template <int L>
+inline void cubic_bezier_clip_lanes(const float (&d)[4][L], float (&t0)[L], float (&t1)[L])
+{
+    float lo[L], hi[L];
+    for (int l = 0; l < L; ++l)
+    {
+        lo[l] = 1.0f;
+        hi[l] = 0.0f;
+    }
+
+    for (int i = 0; i < 4; ++i)
+    {
+        const auto ti = i / 3.0f;
+        for (int l = 0; l < L; ++l)
+        {
+            const auto positive = d[i][l] >= 0.0f;
+            lo[l] = positive && ti < lo[l] ? ti : lo[l];
+            hi[l] = positive && ti > hi[l] ? ti : hi[l];
+        }
+
+        for (int j = i + 1; j < 4; ++j)
+        {
+            for (int l = 0; l < L; ++l)
+            {
+                const auto di      = d[i][l];
+                const auto dj      = d[j][l];
+                const auto crosses = di * dj < 0.0f;
+                const auto t       = (i + (j - i) * di / (crosses ? di - dj : 1.0f)) * (1.0f / 3.0f);
+                lo[l] = crosses && t < lo[l] ? t : lo[l];
+                hi[l] = crosses && t > hi[l] ? t : hi[l];
+            }
+        }
+    }
+
+    for (int l = 0; l < L; ++l)
+    {
+        t0[l] = lo[l] > t0[l] ? lo[l] : t0[l];
+        t1[l] = hi[l] < t1[l] ? hi[l] : t1[l];
+    }
+}
+
+// Replaces control values of a cubic by those of its part between u and w.
+// New values are blossoms (u,u,u), (u,u,w), (u,w,w) and (w,w,w).
+template <int L>
+inline void cubic_bezier_restrict_lanes(float (&c)[4][L], const float (&u)[L], const float (&w)[L])
+{
+    for (int l = 0; l < L; ++l)
+    {
+        const auto u0  = c[0][l] + (c[1][l] - c[0][l]) * u[l];
+        const auto u1  = c[1][l] + (c[2][l] - c[1][l]) * u[l];
+        const auto u2  = c[2][l] + (c[3][l] - c[2][l]) * u[l];
+        const auto w0  = c[0][l] + (c[1][l] - c[0][l]) * w[l];
+        const auto w1  = c[1][l] + (c[2][l] - c[1][l]) * w[l];
+        const auto w2  = c[2][l] + (c[3][l] - c[2][l]) * w[l];
+        const auto uu0 = u0 + (u1 - u0) * u[l];
+        const auto uu1 = u1 + (u2 - u1) * u[l];
+        const auto uw0 = u0 + (u1 - u0) * w[l];
+        const auto uw1 = u1 + (u2 - u1) * w[l];
+        const auto ww0 = w0 + (w1 - w0) * w[l];
+        const auto ww1 = w1 + (w2 - w1) * w[l];
+
+        c[0][l] = uu0 + (uu1 - uu0) * u[l];
+        c[1][l] = uu0 + (uu1 - uu0) * w[l];
+        c[2][l] = uw0 + (uw1 - uw0) * w[l];
+        c[3][l] = ww0 + (ww1 - ww0) * w[l];
+    }
+}
+
+// Single Bezier clipping step. Lane is decided as hit (state 1) when end or
+// middle point of curve is in the rectangle, or as miss (state -1) when no
+// part of curve can be in it. Otherwise curve is cut to part which can be,
+// width is length of that part relative to the previous one. Returns number
+// of lanes still undecided.
+template <int L>
+inline int cubic_bezier_rect_clip_step(float (&x)[4][L], float (&y)[4][L], const rectf& r, int (&state)[L], float (&width)[L])
+{
+    const auto left   = r.left();
+    const auto top    = r.top();
+    const auto right  = r.right();
+    const auto bottom = r.bottom();
+
+    for (int l = 0; l < L; ++l)
+    {
+        const auto mx = (x[0][l] + 3 * (x[1][l] + x[2][l]) + x[3][l]) * 0.125f;
+        const auto my = (y[0][l] + 3 * (y[1][l] + y[2][l]) + y[3][l]) * 0.125f;
+
+        const auto inside =
+            (x[0][l] >= left && x[0][l] <= right && y[0][l] >= top && y[0][l] <= bottom) ||
+            (x[3][l] >= left && x[3][l] <= right && y[3][l] >= top && y[3][l] <= bottom) ||
+            (mx      >= left && mx      <= right && my      >= top && my      <= bottom);
+
+        state[l] = state[l] == 0 && inside ? 1 : state[l];
+    }
+
+    auto undecided = 0;
+    for (int l = 0; l < L; ++l)
+        undecided += state[l] == 0;
+    if (!undecided)
+        return 0;
+
+    float t0[L], t1[L], d[4][L];
+    for (int l = 0; l < L; ++l)
+    {
+        t0[l] = 0.0f;
+        t1[l] = 1.0f;
+    }
+
+    for (int i = 0; i < 4; ++i) for (int l = 0; l < L; ++l) d[i][l] = x[i][l] - left;
+    cubic_bezier_clip_lanes(d, t0, t1);
+    for (int i = 0; i < 4; ++i) for (int l = 0; l < L; ++l) d[i][l] = right - x[i][l];
+    cubic_bezier_clip_lanes(d, t0, t1);
+    for (int i = 0; i < 4; ++i) for (int l = 0; l < L; ++l) d[i][l] = y[i][l] - top;
+    cubic_bezier_clip_lanes(d, t0, t1);
+    for (int i = 0; i < 4; ++i) for (int l = 0; l < L; ++l) d[i][l] = bottom - y[i][l];
+    cubic_bezier_clip_lanes(d, t0, t1);
+
+    // Decided lanes are left as they are
+    undecided = 0;
+    for (int l = 0; l < L; ++l)
+    {
+        width[l] = t1[l] - t0[l];
+        state[l] = state[l] == 0 && t0[l] > t1[l] ? -1 : state[l];
+        t0[l]    = state[l] == 0 ? t0[l] : 0.0f;
+        t1[l]    = state[l] == 0 ? t1[l] : 1.0f;
+        undecided += state[l] == 0;
+    }
+    if (!undecided)
+        return 0;
+
+    cubic_bezier_restrict_lanes(x, t0, t1);
+    cubic_bezier_restrict_lanes(y, t0, t1);
+
+    return undecided;
+}
+
+// Clips single curve until it is decided. Clipping stalls when curve can
+// enter the rectangle more than once, curve is split in half then.
+inline bool cubic_bezier_rect_intersect_impl(float (&x)[4][1], float (&y)[4][1], const rectf& r, int depth = 0)
+{
+    const int max_depth = 16;
+
+    for (int iteration = 0; iteration < 32; ++iteration)
+    {
+        int   state[1] = { 0 };
+        float width[1];
+        cubic_bezier_rect_clip_step(x, y, r, state, width);
+
+        if (state[0] != 0)
+            return state[0] > 0;
+
+        // Curve was cut to a point on rectangle edge
+        if (width[0] < 1e-6f)
+            return true;
+
+        if (width[0] > 0.8f)
+        {
+            if (depth >= max_depth)
+                return true;
+
+            float lx[4][1], ly[4][1];
+            std::copy(&x[0][0], &x[0][0] + 4, &lx[0][0]);
+            std::copy(&y[0][0], &y[0][0] + 4, &ly[0][0]);
+
+            const float zero[1] = { 0.0f }, half[1] = { 0.5f }, one[1] = { 1.0f };
+            cubic_bezier_restrict_lanes(lx, zero, half);
+            cubic_bezier_restrict_lanes(ly, zero, half);
+            cubic_bezier_restrict_lanes(x,  half, one);
+            cubic_bezier_restrict_lanes(y,  half, one);
+
+            return cubic_bezier_rect_intersect_impl(lx, ly, r, depth + 1) || cubic_bezier_rect_intersect_impl(x, y, r, depth + 1);
+        }
+    }
+
+    return true;
+}
+} // namespace detail
+
+// Tests curves against closed rectangle, result is non-zero for a curve
+// which touches it or is inside of it. Curves are clipped to the rectangle
+// four at a time in parallel lanes, few curves left undecided after that
+// are finished one by one.
+inline void cubic_bezier_rect_intersect(const cubic_bezier_t* curves, int count, const rectf& r, int* results)
+{
+    const int lanes      = 4;
+    const int iterations = 4;
+
+    for (int first = 0; first < count; first += lanes)
+    {
+        float x[4][lanes], y[4][lanes], width[lanes];
+        int   state[lanes];
+
+        // Last group is padded with copies of last curve
+        for (int l = 0; l < lanes; ++l)
+        {
+            const auto& curve = curves[std::min(first + l, count - 1)];
+            x[0][l] = curve.p0.x; y[0][l] = curve.p0.y;
+            x[1][l] = curve.p1.x; y[1][l] = curve.p1.y;
+            x[2][l] = curve.p2.x; y[2][l] = curve.p2.y;
+            x[3][l] = curve.p3.x; y[3][l] = curve.p3.y;
+            state[l] = 0;
+        }
+
+        for (int i = 0; i < iterations; ++i)
+            if (!detail::cubic_bezier_rect_clip_step(x, y, r, state, width))
+                break;
+
+        for (int l = 0; l < lanes && first + l < count; ++l)
+        {
+            if (state[l] == 0)
+            {
+                float cx[4][1] = { { x[0][l] }, { x[1][l] }, { x[2][l] }, { x[3][l] } };
+                float cy[4][1] = { { y[0][l] }, { y[1][l] }, { y[2][l] }, { y[3][l] } };
+                state[l] = detail::cubic_bezier_rect_intersect_impl(cx, cy, r) ? 1 : -1;
+            }
+
+            results[first + l] = state[l] > 0 ? 1 : 0;
+        }
+    }
+}
+
+inline bool cubic_bezier_rect_intersect(const cubic_bezier_t& curve, const rectf& r)
+{
+    int result = 0;
+    cubic_bezier_rect_intersect(&curve, 1, r, &result);
+    return result != 0;
+}
+
 struct bezier_fixed_step_result_t
 {
     float  t;
@@ -12,6 +12,7 @@
 
 //------------------------------------------------------------------------------
 # include "imgui/imgui.h"
+# include <cstdint> // uintptr_t
 
 
 //------------------------------------------------------------------------------
@@ -19,6 +20,12 @@ namespace ax {
 namespace NodeEditor {
 
 
+//------------------------------------------------------------------------------
+// Identifies node, pin or link. Pointer sized, so host can use addresses
+// of its own objects or database keys as IDs. Zero is reserved for 'none'.
+typedef uintptr_t ObjectId;
+
+
 //------------------------------------------------------------------------------
 enum class SaveReasonFlags: int
 {
@@ -36,8 +43,8 @@ inline SaveReasonFlags operator &(SaveReasonFlags lhs, SaveReasonFlags rhs) { re
 typedef bool        (*ConfigSaveSettings)(const char* data, size_t size, SaveReasonFlags reason, void* userPointer);
 typedef size_t      (*ConfigLoadSettings)(char* data, void* userPointer);
 
-typedef bool        (*ConfigSaveNodeSettings)(int nodeId, const char* data, size_t size, SaveReasonFlags reason, void* userPointer);
-typedef size_t      (*ConfigLoadNodeSettings)(int nodeId, char* data, void* userPointer);
+typedef bool        (*ConfigSaveNodeSettings)(ObjectId nodeId, const char* data, size_t size, SaveReasonFlags reason, void* userPointer);
+typedef size_t      (*ConfigLoadNodeSettings)(ObjectId nodeId, char* data, void* userPointer);
 
 typedef void        (*ConfigSession)(void* userPointer);
 
@@ -51,6 +58,7 @@ struct Config
     ConfigSaveNodeSettings  SaveNodeSettings;
     ConfigLoadNodeSettings  LoadNodeSettings;
     void*                   UserPointer;
+    int                     ReclaimAfterFrames; // Release objects not submitted for that many frames, 0 keeps them forever
 
     Config():
         SettingsFile("NodeEditor.json"),
@@ -60,7 +68,8 @@ struct Config
         LoadSettings(nullptr),
         SaveNodeSettings(nullptr),
         LoadNodeSettings(nullptr),
-        UserPointer(nullptr)
+        UserPointer(nullptr),
+        ReclaimAfterFrames(0)
     {
     }
 };
@@ -225,8 +234,8 @@ void PopStyleVar(int count = 1);
 void Begin(const char* id, const ImVec2& size = ImVec2(0, 0));
 void End();
 
-void BeginNode(int id);
-void BeginPin(int id, PinKind kind);
+void BeginNode(ObjectId id);
+void BeginPin(ObjectId id, PinKind kind);
 void PinRect(const ImVec2& a, const ImVec2& b);
 void PinPivotRect(const ImVec2& a, const ImVec2& b);
 void PinPivotSize(const ImVec2& size);
@@ -236,7 +245,7 @@ void EndPin();
 void Group(const ImVec2& size);
 void EndNode();
 
-bool BeginGroupHint(int nodeId);
+bool BeginGroupHint(ObjectId nodeId);
 ImVec2 GetGroupMin();
 ImVec2 GetGroupMax();
 ImDrawList* GetHintForegroundDrawList();
@@ -244,17 +253,17 @@ ImDrawList* GetHintBackgroundDrawList();
 void EndGroupHint();
 
 // TODO: Add a way to manage node background channels
-ImDrawList* GetNodeBackgroundDrawList(int nodeId);
+ImDrawList* GetNodeBackgroundDrawList(ObjectId nodeId);
 
-bool Link(int id, int startPinId, int endPinId, const ImVec4& color = ImVec4(1, 1, 1, 1), float thickness = 1.0f);
+bool Link(ObjectId id, ObjectId startPinId, ObjectId endPinId, const ImVec4& color = ImVec4(1, 1, 1, 1), float thickness = 1.0f);
 
-void Flow(int linkId);
+void Flow(ObjectId linkId);
 
 bool BeginCreate(const ImVec4& color = ImVec4(1, 1, 1, 1), float thickness = 1.0f);
-bool QueryNewLink(int* startId, int* endId);
-bool QueryNewLink(int* startId, int* endId, const ImVec4& color, float thickness = 1.0f);
-bool QueryNewNode(int* pinId);
-bool QueryNewNode(int* pinId, const ImVec4& color, float thickness = 1.0f);
+bool QueryNewLink(ObjectId* startId, ObjectId* endId);
+bool QueryNewLink(ObjectId* startId, ObjectId* endId, const ImVec4& color, float thickness = 1.0f);
+bool QueryNewNode(ObjectId* pinId);
+bool QueryNewNode(ObjectId* pinId, const ImVec4& color, float thickness = 1.0f);
 bool AcceptNewItem();
 bool AcceptNewItem(const ImVec4& color, float thickness = 1.0f);
 void RejectNewItem();
@@ -262,18 +271,18 @@ void RejectNewItem(const ImVec4& color, float thickness = 1.0f);
 void EndCreate();
 
 bool BeginDelete();
-bool QueryDeletedLink(int* linkId, int* startId = nullptr, int* endId = nullptr);
-bool QueryDeletedNode(int* nodeId);
+bool QueryDeletedLink(ObjectId* linkId, ObjectId* startId = nullptr, ObjectId* endId = nullptr);
+bool QueryDeletedNode(ObjectId* nodeId);
 bool AcceptDeletedItem();
 void RejectDeletedItem();
 void EndDelete();
 
-void SetNodePosition(int nodeId, const ImVec2& editorPosition);
-ImVec2 GetNodePosition(int nodeId);
-ImVec2 GetNodeSize(int nodeId);
-void CenterNodeOnScreen(int nodeId);
+void SetNodePosition(ObjectId nodeId, const ImVec2& editorPosition);
+ImVec2 GetNodePosition(ObjectId nodeId);
+ImVec2 GetNodeSize(ObjectId nodeId);
+void CenterNodeOnScreen(ObjectId nodeId);
 
-void RestoreNodeState(int nodeId);
+void RestoreNodeState(ObjectId nodeId);
 
 void Suspend();
 void Resume();
@@ -283,23 +292,23 @@ bool IsActive();
 
 bool HasSelectionChanged();
 int  GetSelectedObjectCount();
-int  GetSelectedNodes(int* nodes, int size);
-int  GetSelectedLinks(int* links, int size);
+int  GetSelectedNodes(ObjectId* nodes, int size);
+int  GetSelectedLinks(ObjectId* links, int size);
 void ClearSelection();
-void SelectNode(int nodeId, bool append = false);
-void SelectLink(int linkId, bool append = false);
-void DeselectNode(int nodeId);
-void DeselectLink(int linkId);
+void SelectNode(ObjectId nodeId, bool append = false);
+void SelectLink(ObjectId linkId, bool append = false);
+void DeselectNode(ObjectId nodeId);
+void DeselectLink(ObjectId linkId);
 
-bool DeleteNode(int nodeId);
-bool DeleteLink(int linkId);
+bool DeleteNode(ObjectId nodeId);
+bool DeleteLink(ObjectId linkId);
 
 void NavigateToContent(float duration = -1);
 void NavigateToSelection(bool zoomIn = false, float duration = -1);
 
-bool ShowNodeContextMenu(int* nodeId);
-bool ShowPinContextMenu(int* pinId);
-bool ShowLinkContextMenu(int* linkId);
+bool ShowNodeContextMenu(ObjectId* nodeId);
+bool ShowPinContextMenu(ObjectId* pinId);
+bool ShowLinkContextMenu(ObjectId* linkId);
 bool ShowBackgroundContextMenu();
 
 void EnableShortcuts(bool enable);
@@ -312,19 +321,27 @@ bool AcceptPaste();
 bool AcceptDuplicate();
 bool AcceptCreateNode();
 int  GetActionContextSize();
-int  GetActionContextNodes(int* nodes, int size);
-int  GetActionContextLinks(int* links, int size);
+int  GetActionContextNodes(ObjectId* nodes, int size);
+int  GetActionContextLinks(ObjectId* links, int size);
 void EndShortcut();
 
 float GetCurrentZoom();
 
-int GetDoubleClickedNode();
-int GetDoubleClickedPin();
-int GetDoubleClickedLink();
+ObjectId GetDoubleClickedNode();
+ObjectId GetDoubleClickedPin();
+ObjectId GetDoubleClickedLink();
 bool IsBackgroundClicked();
 bool IsBackgroundDoubleClicked();
 
-bool PinHadAnyLinks(int pinId);
+bool PinHadAnyLinks(ObjectId pinId);
+
+// Live links attached to node or pin. Pass null list to get the count.
+int  GetNodeLinks(ObjectId nodeId, ObjectId* links, int size);
+int  GetPinLinks(ObjectId pinId, ObjectId* links, int size);
+
+// Live nodes placed directly in group. Nodes of nested groups are reported
+// by those groups. Pass null list to get the count.
+int  GetGroupChildren(ObjectId nodeId, ObjectId* nodes, int size);
 
 ImVec2 GetScreenSize();
 ImVec2 ScreenToCanvas(const ImVec2& pos);
@@ -8,11 +8,15 @@
 //   Written by Michal Cichon
 //------------------------------------------------------------------------------
 # include "NodeEditorImpl.h"
-# include <cstdlib> // _itoa
+# include <cstdlib> // _ui64toa
 # include <string>
 # include <fstream>
 # include <bitset>
 # include <optional>
+# if defined(_M_IX86) || defined(_M_X64) || defined(__SSE__)
+#     include <xmmintrin.h>
+#     define AX_NODE_EDITOR_SSE 1
+# endif
 
 
 //------------------------------------------------------------------------------
@@ -41,7 +45,7 @@ static const int c_LinkChannel_Links      = c_LinkStartChannel + 1;
 static const int c_LinkChannel_Flow       = c_LinkStartChannel + 2;
 static const int c_LinkChannel_NewLink    = c_LinkStartChannel + 3;
 
-static const int c_ChannelsPerNode           = 5;
+static const int c_NodeChannelCount          = 5; // shared by all nodes
 static const int c_NodeBaseChannel           = 0;
 static const int c_NodeBackgroundChannel     = 1;
 static const int c_NodeUserBackgroundChannel = 2;
@@ -49,7 +53,12 @@ static const int c_NodePinChannel            = 3;
 static const int c_NodeContentChannel        = 4;
 
 static const float c_GroupSelectThickness       = 3.0f;  // canvas pixels
+static const float c_GridSpacing                = 32.0f; // canvas pixels, finest level of grid
+static const float c_GridMinSpacing             = 8.0f;  // screen pixels, grid level is coarsened below that
+static const int   c_GridLevelFactor            = 4;     // spacing of next grid level, every n-th line is major
+static const int   c_GridMaxLines               = 256;   // per axis
 static const float c_LinkSelectThickness        = 5.0f;  // canvas pixels
+static const float c_LinkPolylineTolerance      = 1.5f;  // canvas pixels, max distance of flattened link from its curve
 static const float c_NavigationZoomMargin       = 0.1f;  // percentage of visible bounds
 static const float c_MouseZoomDuration          = 0.15f; // seconds
 static const float c_SelectionFadeOutDuration   = 0.15f; // seconds
@@ -97,6 +106,74 @@ static bool IsGroup(const ed::Node* node)
 }
 
 
+//------------------------------------------------------------------------------
+// Returns true if squared distance from point to any segment of polyline
+// does not exceed maxDistanceSq.
+static bool Polyline_IsPointNear(const ax::pointf* points, int count, const ax::pointf& p, float maxDistanceSq)
+{
+    if (count <= 0)
+        return false;
+    if (count == 1)
+        return (points[0] - p).length_sq() <= maxDistanceSq;
+
+    const auto segmentCount = count - 1;
+    auto i = 0;
+
+# if AX_NODE_EDITOR_SSE
+    // Four segments at a time
+    const auto px    = _mm_set1_ps(p.x);
+    const auto py    = _mm_set1_ps(p.y);
+    const auto zero  = _mm_setzero_ps();
+    const auto one   = _mm_set1_ps(1.0f);
+    const auto eps   = _mm_set1_ps(1e-12f);
+    const auto limit = _mm_set1_ps(maxDistanceSq);
+    for (; i + 4 <= segmentCount; i += 4)
+    {
+        const auto* s = points + i;
+
+        const auto ax_ = _mm_setr_ps(s[0].x, s[1].x, s[2].x, s[3].x);
+        const auto ay_ = _mm_setr_ps(s[0].y, s[1].y, s[2].y, s[3].y);
+        const auto bx_ = _mm_setr_ps(s[1].x, s[2].x, s[3].x, s[4].x);
+        const auto by_ = _mm_setr_ps(s[1].y, s[2].y, s[3].y, s[4].y);
+
+        const auto dx  = _mm_sub_ps(bx_, ax_);
+        const auto dy  = _mm_sub_ps(by_, ay_);
+        const auto qx  = _mm_sub_ps(px, ax_);
+        const auto qy  = _mm_sub_ps(py, ay_);
+
+        const auto dd  = _mm_max_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), eps);
+        const auto qd  = _mm_add_ps(_mm_mul_ps(qx, dx), _mm_mul_ps(qy, dy));
+        const auto t   = _mm_min_ps(_mm_max_ps(_mm_div_ps(qd, dd), zero), one);
+
+        const auto ex  = _mm_sub_ps(qx, _mm_mul_ps(dx, t));
+        const auto ey  = _mm_sub_ps(qy, _mm_mul_ps(dy, t));
+        const auto ee  = _mm_add_ps(_mm_mul_ps(ex, ex), _mm_mul_ps(ey, ey));
+
+        if (_mm_movemask_ps(_mm_cmple_ps(ee, limit)))
+            return true;
+    }
+# endif
+
+    for (; i < segmentCount; ++i)
+    {
+        const auto& a = points[i];
+        const auto& b = points[i + 1];
+
+        const auto d  = b - a;
+        const auto q  = p - a;
+        const auto dd = std::max(d.x * d.x + d.y * d.y, 1e-12f);
+        const auto t  = std::min(std::max((q.x * d.x + q.y * d.y) / dd, 0.0f), 1.0f);
+        const auto ex = q.x - d.x * t;
+        const auto ey = q.y - d.y * t;
+
+        if (ex * ex + ey * ey <= maxDistanceSq)
+            return true;
+    }
+
+    return false;
+}
+
+
 //------------------------------------------------------------------------------
 static void ImDrawList_ChannelsGrow(ImDrawList* draw_list, int channels_count)
 {
@@ -123,7 +200,7 @@ static void ImDrawList_ChannelsGrow(ImDrawList* draw_list, int channels_count)
         if (draw_list->_Channels[i].CmdBuffer.Size == 0)
         {
             ImDrawCmd draw_cmd;
-            draw_cmd.ClipRect  = draw_list->_ClipRectStack.back();
+            draw_cmd.ClipRect  = draw_list->GetCurrentClipRect();
             draw_cmd.TextureId = draw_list->_TextureIdStack.back();
             draw_list->_Channels[i].CmdBuffer.push_back(draw_cmd);
         }
@@ -152,94 +229,105 @@ static void ImDrawList_SwapChannels(ImDrawList* drawList, int left, int right)
         drawList->_ChannelsCurrent = left;
 }
 
-static void ImDrawList_TransformChannel_Inner(ImVector<ImDrawVert>& vtxBuffer, const ImVector<ImDrawIdx>& idxBuffer, const ImVector<ImDrawCmd>& cmdBuffer, const ImVec2& preOffset, const ImVec2& scale, const ImVec2& postOffset)
+// Appends part of 'source' channel covering [idxBegin, idxEnd) index range to
+// 'target' channel. Commands are split at range boundaries, neighbouring
+// commands with same state are joined. Callbacks go with the range they start in.
+static void ImDrawList_AppendChannelRange(ImDrawChannel& target, const ImDrawChannel& source, int cmdIndex, int cmdIdxStart, int idxBegin, int idxEnd)
 {
-    auto idxRead = idxBuffer.Data;
-
-    int indexOffset = 0;
-    for (auto& cmd : cmdBuffer)
+    for (; cmdIndex < source.CmdBuffer.Size && cmdIdxStart < idxEnd; ++cmdIndex)
     {
-        auto idxCount = cmd.ElemCount;
+        const auto& cmd = source.CmdBuffer[cmdIndex];
 
-        if (idxCount == 0) continue;
+        const auto begin = std::max(cmdIdxStart, idxBegin);
+        const auto end   = std::min(cmdIdxStart + static_cast<int>(cmd.ElemCount), idxEnd);
+        cmdIdxStart += cmd.ElemCount;
 
-        auto minIndex = idxRead[indexOffset];
-        auto maxIndex = idxRead[indexOffset];
+        if (cmd.UserCallback == nullptr && begin >= end)
+            continue;
 
-        for (auto i = 1u; i < idxCount; ++i)
+        auto last = target.CmdBuffer.Size ? &target.CmdBuffer.back() : nullptr;
+        if (last && last->UserCallback == nullptr && cmd.UserCallback == nullptr && last->TextureId == cmd.TextureId &&
+            memcmp(&last->ClipRect, &cmd.ClipRect, sizeof(ImVec4)) == 0)
         {
-            auto idx = idxRead[indexOffset + i];
-            minIndex = std::min(minIndex, idx);
-            maxIndex = std::max(maxIndex, idx);
+            last->ElemCount += end - begin;
         }
-
-        for (auto vtx = vtxBuffer.Data + minIndex, vtxEnd = vtxBuffer.Data + maxIndex + 1; vtx < vtxEnd; ++vtx)
+        else
         {
-            vtx->pos.x = (vtx->pos.x + preOffset.x) * scale.x + postOffset.x;
-            vtx->pos.y = (vtx->pos.y + preOffset.y) * scale.y + postOffset.y;
+            target.CmdBuffer.push_back(cmd);
+            target.CmdBuffer.back().ElemCount = std::max(end - begin, 0);
         }
 
-        indexOffset += idxCount;
+        if (end > begin)
+        {
+            const auto idxCount = target.IdxBuffer.Size;
+            target.IdxBuffer.resize(idxCount + end - begin);
+            memcpy(target.IdxBuffer.Data + idxCount, source.IdxBuffer.Data + begin, (end - begin) * sizeof(ImDrawIdx));
+        }
     }
 }
 
-static void ImDrawList_TransformChannels(ImDrawList* drawList, int begin, int end, const ImVec2& preOffset, const ImVec2& scale, const ImVec2& postOffset)
+// Grid lines are spaced c_GridSpacing, multiplied by c_GridLevelFactor as many
+// times as needed to keep them at least c_GridMinSpacing apart on screen. Minor
+// lines fade out as their spacing approaches that minimum, so switching levels
+// is not visible. Lines are pixel wide quads emitted in one batch.
+static void ImDrawList_AddGrid(ImDrawList* drawList, const ImVec2& min, const ImVec2& max, const ImVec2& origin, const ImVec2& zoom, ImU32 color)
 {
-    int lastCurrentChannel = drawList->_ChannelsCurrent;
-    if (lastCurrentChannel != 0)
-        drawList->ChannelsSetCurrent(0);
-
-    auto& vtxBuffer = drawList->VtxBuffer;
+    const auto scale  = std::min(zoom.x, zoom.y);
+    const auto extent = std::max(max.x - min.x, max.y - min.y);
+    if (scale <= 0.0f || extent <= 0.0f)
+        return;
 
-    if (begin == 0 && begin != end)
-    {
-        ImDrawList_TransformChannel_Inner(vtxBuffer, drawList->IdxBuffer, drawList->CmdBuffer, preOffset, scale, postOffset);
-        ++begin;
-    }
+    auto spacing = c_GridSpacing;
+    while (spacing * scale < c_GridMinSpacing || extent > spacing * scale * c_GridMaxLines)
+        spacing *= c_GridLevelFactor;
+
+    const auto fade       = std::min((spacing * scale - c_GridMinSpacing) / (c_GridMinSpacing * (c_GridLevelFactor - 1)), 1.0f);
+    const auto alpha      = static_cast<ImU32>(((color >> IM_COL32_A_SHIFT) & 0xFF) * fade);
+    const auto minorColor = (color & ~(0xFFu << IM_COL32_A_SHIFT)) | (alpha << IM_COL32_A_SHIFT);
+    const auto drawMinor  = alpha > 0;
+
+    // Line i is placed at origin + i * step, lines in [min, max) are drawn
+    const ImVec2 step(spacing * zoom.x, spacing * zoom.y);
+    const int firstX = static_cast<int>(ceilf((min.x - origin.x) / step.x));
+    const int lastX  = static_cast<int>(ceilf((max.x - origin.x) / step.x)) - 1;
+    const int firstY = static_cast<int>(ceilf((min.y - origin.y) / step.y));
+    const int lastY  = static_cast<int>(ceilf((max.y - origin.y) / step.y)) - 1;
+
+    auto floorDiv = [](int a, int b) { return a / b - (a % b < 0 ? 1 : 0); };
+    auto lineCount = [&](int first, int last)
+    {
+        if (last < first)
+            return 0;
+        if (drawMinor)
+            return last - first + 1;
+        return floorDiv(last, c_GridLevelFactor) - floorDiv(first - 1, c_GridLevelFactor);
+    };
 
-    for (int channelIndex = begin; channelIndex < end; ++channelIndex)
-    {
-        auto& channel = drawList->_Channels[channelIndex];
-        ImDrawList_TransformChannel_Inner(vtxBuffer, channel.IdxBuffer, channel.CmdBuffer, preOffset, scale, postOffset);
-    }
+    const int count = lineCount(firstX, lastX) + lineCount(firstY, lastY);
+    if (count == 0)
+        return;
 
-    if (lastCurrentChannel != 0)
-        drawList->ChannelsSetCurrent(lastCurrentChannel);
-}
+    drawList->PrimReserve(count * 6, count * 4);
 
-static void ImDrawList_ClampClipRects_Inner(ImVector<ImDrawCmd>& cmdBuffer, const ImVec4& clipRect, const ImVec2& offset)
-{
-    for (auto& cmd : cmdBuffer)
+    for (int i = firstX; i <= lastX; ++i)
     {
-        cmd.ClipRect.x = std::max(cmd.ClipRect.x + offset.x, clipRect.x);
-        cmd.ClipRect.y = std::max(cmd.ClipRect.y + offset.y, clipRect.y);
-        cmd.ClipRect.z = std::min(cmd.ClipRect.z + offset.x, clipRect.z);
-        cmd.ClipRect.w = std::min(cmd.ClipRect.w + offset.y, clipRect.w);
-    }
-}
-
-static void ImDrawList_TranslateAndClampClipRects(ImDrawList* drawList, int begin, int end, const ImVec2& offset)
-{
-    int lastCurrentChannel = drawList->_ChannelsCurrent;
-    if (lastCurrentChannel != 0)
-        drawList->ChannelsSetCurrent(0);
-
-    auto clipRect = drawList->_ClipRectStack.back();
+        const auto isMajor = (i % c_GridLevelFactor) == 0;
+        if (!isMajor && !drawMinor)
+            continue;
 
-    if (begin == 0 && begin != end)
-    {
-        ImDrawList_ClampClipRects_Inner(drawList->CmdBuffer, clipRect, offset);
-        ++begin;
+        const auto x = floorf(origin.x + i * step.x);
+        drawList->PrimRect(ImVec2(x, min.y), ImVec2(x + 1.0f, max.y), isMajor ? color : minorColor);
     }
 
-    for (int channelIndex = begin; channelIndex < end; ++channelIndex)
+    for (int i = firstY; i <= lastY; ++i)
     {
-        auto& channel = drawList->_Channels[channelIndex];
-        ImDrawList_ClampClipRects_Inner(channel.CmdBuffer, clipRect, offset);
-    }
+        const auto isMajor = (i % c_GridLevelFactor) == 0;
+        if (!isMajor && !drawMinor)
+            continue;
 
-    if (lastCurrentChannel != 0)
-        drawList->ChannelsSetCurrent(lastCurrentChannel);
+        const auto y = floorf(origin.y + i * step.y);
+        drawList->PrimRect(ImVec2(min.x, y), ImVec2(max.x, y + 1.0f), isMajor ? color : minorColor);
+    }
 }
 
 static void ImDrawList_PathBezierOffset(ImDrawList* drawList, float offset, const ImVec2& p0, const ImVec2& p1, const ImVec2& p2, const ImVec2& p3)
@@ -447,6 +535,147 @@ static void ImDrawList_AddBezierWithArrows(ImDrawList* drawList, const ax::cubic
 
 
 
+//------------------------------------------------------------------------------
+//
+// Object Index
+//
+//------------------------------------------------------------------------------
+ed::Object* ed::ObjectIndex::Find(ObjectId id, ObjectType type) const
+{
+    auto object = Find(id);
+    return object && object->TypeTag == type ? object : nullptr;
+}
+
+
+
+
+//------------------------------------------------------------------------------
+//
+// Visibility Set
+//
+//------------------------------------------------------------------------------
+int ed::VisibilitySet::Add(Object* object, const rectf& bounds)
+{
+    int slot;
+    if (!FreeSlots.empty())
+    {
+        slot = FreeSlots.back();
+        FreeSlots.pop_back();
+    }
+    else
+    {
+        slot = Count++;
+
+        // Grow by whole words of bitset, unused slots never pass the test
+        if (static_cast<size_t>(slot) >= MinX.size())
+        {
+            const auto size = MinX.size() + 32;
+            MinX.resize(size,  FLT_MAX);
+            MinY.resize(size,  FLT_MAX);
+            MaxX.resize(size, -FLT_MAX);
+            MaxY.resize(size, -FLT_MAX);
+            LiveFrames.resize(size, -1);
+            Objects.resize(size, nullptr);
+            Bits.resize(size / 32, 0);
+        }
+    }
+
+    LiveFrames[slot] = object->LiveFrame;
+    Objects[slot]    = object;
+    Update(slot, bounds);
+
+    return slot;
+}
+
+void ed::VisibilitySet::Update(int slot, const rectf& bounds)
+{
+    MinX[slot] = bounds.left();
+    MinY[slot] = bounds.top();
+    MaxX[slot] = bounds.right();
+    MaxY[slot] = bounds.bottom();
+}
+
+void ed::VisibilitySet::Remove(int slot)
+{
+    MinX[slot] =  FLT_MAX;
+    MinY[slot] =  FLT_MAX;
+    MaxX[slot] = -FLT_MAX;
+    MaxY[slot] = -FLT_MAX;
+    LiveFrames[slot] = -1;
+    Objects[slot]    = nullptr;
+    Bits[slot >> 5] &= ~(1u << (slot & 31));
+
+    FreeSlots.push_back(slot);
+}
+
+int ed::VisibilitySet::CountLive(int frameIndex) const
+{
+    return static_cast<int>(std::count(LiveFrames.begin(), LiveFrames.end(), frameIndex));
+}
+
+void ed::VisibilitySet::Cull(const rectf& visibleBounds, int frameIndex)
+{
+    // Same test as ImGui::IsRectVisible
+    const auto left   = visibleBounds.left();
+    const auto top    = visibleBounds.top();
+    const auto right  = visibleBounds.right();
+    const auto bottom = visibleBounds.bottom();
+
+# if AX_NODE_EDITOR_SSE
+    const auto l = _mm_set1_ps(left);
+    const auto t = _mm_set1_ps(top);
+    const auto r = _mm_set1_ps(right);
+    const auto b = _mm_set1_ps(bottom);
+# endif
+
+    VisibleObjects.clear();
+
+    const auto wordCount = Bits.size();
+    for (size_t word = 0; word < wordCount; ++word)
+    {
+        const auto firstSlot = word * 32;
+
+        uint32_t bits = 0;
+# if AX_NODE_EDITOR_SSE
+        // Four slots at a time
+        const auto minX = MinX.data() + firstSlot;
+        const auto minY = MinY.data() + firstSlot;
+        const auto maxX = MaxX.data() + firstSlot;
+        const auto maxY = MaxY.data() + firstSlot;
+        for (int i = 0; i < 32; i += 4)
+        {
+            const auto inX = _mm_and_ps(_mm_cmplt_ps(_mm_loadu_ps(minX + i), r), _mm_cmpgt_ps(_mm_loadu_ps(maxX + i), l));
+            const auto inY = _mm_and_ps(_mm_cmplt_ps(_mm_loadu_ps(minY + i), b), _mm_cmpgt_ps(_mm_loadu_ps(maxY + i), t));
+            bits |= static_cast<uint32_t>(_mm_movemask_ps(_mm_and_ps(inX, inY))) << i;
+        }
+# else
+        for (size_t i = 0, slot = firstSlot; i < 32; ++i, ++slot)
+        {
+            if (MinX[slot] < right && MaxX[slot] > left && MinY[slot] < bottom && MaxY[slot] > top)
+                bits |= 1u << i;
+        }
+# endif
+
+        // Objects not submitted in this frame are not visible, live frames
+        // are read only for slots which passed the bounds test
+        for (size_t i = 0, slot = firstSlot; i < 32 && (bits >> i); ++i, ++slot)
+        {
+            if (!((bits >> i) & 1))
+                continue;
+
+            if (LiveFrames[slot] == frameIndex)
+                VisibleObjects.push_back(Objects[slot]);
+            else
+                bits &= ~(1u << i);
+        }
+
+        Bits[word] = bits;
+    }
+}
+
+
+
+
 //------------------------------------------------------------------------------
 //
 // Pin
@@ -456,7 +685,7 @@ void ed::Pin::Draw(ImDrawList* drawList, DrawFlags flags)
 {
     if (flags & Hovered)
     {
-        drawList->ChannelsSetCurrent(Node->Channel + c_NodePinChannel);
+        Editor->SetNodeDrawLayer(drawList, Node, c_NodePinChannel);
 
         drawList->AddRectFilled(to_imvec(Bounds.top_left()), to_imvec(Bounds.bottom_right()),
             Color, Rounding, Corners);
@@ -474,6 +703,19 @@ void ed::Pin::Draw(ImDrawList* drawList, DrawFlags flags)
     }
 }
 
+void ed::Pin::DetachDeadLinks()
+{
+    // Pins are submitted before links, links of previous frame stay
+    const auto lastFrame = Editor->GetFrameIndex() - 1;
+    for (size_t i = 0; i < Links.size();)
+    {
+        if (Links[i]->LiveFrame >= lastFrame)
+            ++i;
+        else
+            Links[i]->DetachPins(); // replaces Links[i] with last one
+    }
+}
+
 ImVec2 ed::Pin::GetClosestPoint(const ImVec2& p) const
 {
     return to_imvec(Pivot.get_closest_point(to_pointf(p), true, Radius + ArrowSize));
@@ -501,6 +743,7 @@ bool ed::Node::AcceptDrag()
 void ed::Node::UpdateDrag(const ax::point& offset)
 {
     Bounds.location = DragStart + offset;
+    Editor->NotifyNodeBoundsChanged(this);
 }
 
 bool ed::Node::EndDrag()
@@ -512,7 +755,7 @@ void ed::Node::Draw(ImDrawList* drawList, DrawFlags flags)
 {
     if (flags == Detail::Object::None)
     {
-        drawList->ChannelsSetCurrent(Channel + c_NodeBackgroundChannel);
+        Editor->SetNodeDrawLayer(drawList, this, c_NodeBackgroundChannel);
 
         drawList->AddRectFilled(
             to_imvec(Bounds.top_left()),
@@ -546,7 +789,7 @@ void ed::Node::Draw(ImDrawList* drawList, DrawFlags flags)
         const auto  borderColor = Editor->GetColor(StyleColor_SelNodeBorder);
         const auto& editorStyle = Editor->GetStyle();
 
-        drawList->ChannelsSetCurrent(Channel + c_NodeBaseChannel);
+        Editor->SetNodeDrawLayer(drawList, this, c_NodeBaseChannel);
 
         DrawBorder(drawList, borderColor, editorStyle.SelectedNodeBorderWidth);
     }
@@ -555,7 +798,7 @@ void ed::Node::Draw(ImDrawList* drawList, DrawFlags flags)
         const auto  borderColor = Editor->GetColor(StyleColor_HovNodeBorder);
         const auto& editorStyle = Editor->GetStyle();
 
-        drawList->ChannelsSetCurrent(Channel + c_NodeBaseChannel);
+        Editor->SetNodeDrawLayer(drawList, this, c_NodeBaseChannel);
 
         DrawBorder(drawList, borderColor, editorStyle.HoveredNodeBorderWidth);
     }
@@ -578,11 +821,15 @@ void ed::Node::GetGroupedNodes(std::vector<Node*>& result, bool append)
     if (!IsGroup(this))
         return;
 
+    // Every node lying fully within group area moves with the group, also
+    // one which belongs to smaller overlapping group. Hierarchy keeps only
+    // the smallest group of a node, so grid is queried. Whole subtree of
+    // this group is within its area, nested groups need no extra queries
+    // and no node is reported twice.
     const auto firstNodeIndex = result.size();
     Editor->FindNodesInRect(static_cast<ax::rectf>(GroupBounds), result, true, false);
 
-    for (auto index = firstNodeIndex, lastNodeIndex = result.size(); index < result.size(); ++index)
-        result[index]->GetGroupedNodes(result, true);
+    result.erase(std::remove(result.begin() + firstNodeIndex, result.end(), this), result.end());
 }
 
 
@@ -625,10 +872,10 @@ void ed::Link::Draw(ImDrawList* drawList, ImU32 color, float extraThickness) con
 {
     using namespace ax::ImGuiInterop;
 
-    if (!IsLive)
+    if (!IsLive())
         return;
 
-    const auto curve = GetCurve();
+    const auto& curve = GetCurve();
 
     ImDrawList_AddBezierWithArrows(drawList, curve, Thickness + extraThickness,
         StartPin && StartPin->ArrowSize  > 0.0f ? StartPin->ArrowSize  + extraThickness : 0.0f,
@@ -638,6 +885,35 @@ void ed::Link::Draw(ImDrawList* drawList, ImU32 color, float extraThickness) con
         true, color, 1.0f);
 }
 
+void ed::Link::AttachPins(Pin* startPin, Pin* endPin)
+{
+    DetachPins();
+
+    StartPin = startPin;
+    EndPin   = endPin;
+
+    if (StartPin)
+        StartPin->AttachLink(this);
+    if (EndPin && EndPin != StartPin)
+        EndPin->AttachLink(this);
+
+    IsAttached = StartPin || EndPin;
+}
+
+// Pins are kept, link is attached back by DoLink() when submitted again.
+void ed::Link::DetachPins()
+{
+    if (!IsAttached)
+        return;
+
+    if (StartPin)
+        StartPin->DetachLink(this);
+    if (EndPin && EndPin != StartPin)
+        EndPin->DetachLink(this);
+
+    IsAttached = false;
+}
+
 void ed::Link::UpdateEndpoints()
 {
     const auto line = StartPin->GetClosestLine(EndPin);
@@ -645,7 +921,7 @@ void ed::Link::UpdateEndpoints()
     End   = to_imvec(line.b);
 }
 
-ax::cubic_bezier_t ed::Link::GetCurve() const
+void ed::Link::UpdateGeometry()
 {
     auto easeLinkStrength = [](const ImVec2& a, const ImVec2& b, float strength)
     {
@@ -665,12 +941,72 @@ ax::cubic_bezier_t ed::Link::GetCurve() const
     const auto           cp0 = Start + StartPin->Dir * startStrength;
     const auto           cp1 =   End +   EndPin->Dir *   endStrength;
 
-    return ax::cubic_bezier_t { to_pointf(Start), to_pointf(cp0), to_pointf(cp1), to_pointf(End) };
+    Curve = ax::cubic_bezier_t { to_pointf(Start), to_pointf(cp0), to_pointf(cp1), to_pointf(End) };
+
+    const auto& curve = Curve;
+    auto bounds = cubic_bezier_bounding_rect(curve.p0, curve.p1, curve.p2, curve.p3);
+
+    if (bounds.w == 0.0f)
+    {
+        bounds.x -= 0.5f;
+        bounds.w  = 1.0f;
+    }
+
+    if (bounds.h == 0.0f)
+    {
+        bounds.y -= 0.5f;
+        bounds.h = 1.0f;
+    }
+
+    if (StartPin->ArrowSize)
+    {
+        const auto start_dir = curve.tangent(0.0f).normalized();
+        const auto p0 = curve.p0;
+        const auto p1 = curve.p0 - start_dir * StartPin->ArrowSize;
+        const auto min = p0.cwise_min(p1);
+        const auto max = p0.cwise_max(p1);
+        auto arrowBounds = rectf(min, max);
+        arrowBounds.w = std::max(arrowBounds.w, 1.0f);
+        arrowBounds.h = std::max(arrowBounds.h, 1.0f);
+        bounds = make_union(bounds, arrowBounds);
+    }
+
+    if (EndPin->ArrowSize)
+    {
+        const auto end_dir = curve.tangent(0.0f).normalized();
+        const auto p0 = curve.p3;
+        const auto p1 = curve.p3 + end_dir * EndPin->ArrowSize;
+        const auto min = p0.cwise_min(p1);
+        const auto max = p0.cwise_max(p1);
+        auto arrowBounds = rectf(min, max);
+        arrowBounds.w = std::max(arrowBounds.w, 1.0f);
+        arrowBounds.h = std::max(arrowBounds.h, 1.0f);
+        bounds = make_union(bounds, arrowBounds);
+    }
+
+    Bounds = bounds;
+
+    Polyline.resize(0);
+}
+
+const std::vector<ax::pointf>& ed::Link::GetPolyline() const
+{
+    if (Polyline.empty())
+    {
+        auto collectPoints = [this](const bezier_subdivide_result_t& result)
+        {
+            Polyline.push_back(result.point);
+        };
+
+        cubic_bezier_subdivide(collectPoints, Curve);
+    }
+
+    return Polyline;
 }
 
 bool ed::Link::TestHit(const ImVec2& point, float extraThickness) const
 {
-    if (!IsLive)
+    if (!IsLive())
         return false;
 
     auto bounds = GetBounds();
@@ -680,7 +1016,7 @@ bool ed::Link::TestHit(const ImVec2& point, float extraThickness) const
     if (!bounds.contains(to_pointf(point)))
         return false;
 
-    const auto bezier = GetCurve();
+    const auto& bezier = GetCurve();
     const auto result = cubic_bezier_project_point(to_pointf(point), bezier.p0, bezier.p1, bezier.p2, bezier.p3, 50);
 
     return result.distance <= Thickness + extraThickness;
@@ -688,7 +1024,7 @@ bool ed::Link::TestHit(const ImVec2& point, float extraThickness) const
 
 bool ed::Link::TestHit(const ax::rectf& rect, bool allowIntersect) const
 {
-    if (!IsLive)
+    if (!IsLive())
         return false;
 
     const auto bounds = GetBounds();
@@ -699,75 +1035,12 @@ bool ed::Link::TestHit(const ax::rectf& rect, bool allowIntersect) const
     if (!allowIntersect || !rect.intersects(bounds))
         return false;
 
-    const auto bezier = GetCurve();
-
-    const auto p0 = rect.top_left();
-    const auto p1 = rect.top_right();
-    const auto p2 = rect.bottom_right();
-    const auto p3 = rect.bottom_left();
-
-    pointf points[3];
-    if (cubic_bezier_line_intersect(bezier.p0, bezier.p1, bezier.p2, bezier.p3, p0, p1, points) > 0)
-        return true;
-    if (cubic_bezier_line_intersect(bezier.p0, bezier.p1, bezier.p2, bezier.p3, p1, p2, points) > 0)
-        return true;
-    if (cubic_bezier_line_intersect(bezier.p0, bezier.p1, bezier.p2, bezier.p3, p2, p3, points) > 0)
-        return true;
-    if (cubic_bezier_line_intersect(bezier.p0, bezier.p1, bezier.p2, bezier.p3, p3, p0, points) > 0)
-        return true;
-
-    return false;
+    return cubic_bezier_rect_intersect(GetCurve(), rect);
 }
 
 ax::rectf ed::Link::GetBounds() const
 {
-    if (IsLive)
-    {
-        const auto curve = GetCurve();
-        auto bounds = cubic_bezier_bounding_rect(curve.p0, curve.p1, curve.p2, curve.p3);
-
-        if (bounds.w == 0.0f)
-        {
-            bounds.x -= 0.5f;
-            bounds.w  = 1.0f;
-        }
-
-        if (bounds.h == 0.0f)
-        {
-            bounds.y -= 0.5f;
-            bounds.h = 1.0f;
-        }
-
-        if (StartPin->ArrowSize)
-        {
-            const auto start_dir = curve.tangent(0.0f).normalized();
-            const auto p0 = curve.p0;
-            const auto p1 = curve.p0 - start_dir * StartPin->ArrowSize;
-            const auto min = p0.cwise_min(p1);
-            const auto max = p0.cwise_max(p1);
-            auto arrowBounds = rectf(min, max);
-            arrowBounds.w = std::max(arrowBounds.w, 1.0f);
-            arrowBounds.h = std::max(arrowBounds.h, 1.0f);
-            bounds = make_union(bounds, arrowBounds);
-        }
-
-        if (EndPin->ArrowSize)
-        {
-            const auto end_dir = curve.tangent(0.0f).normalized();
-            const auto p0 = curve.p3;
-            const auto p1 = curve.p3 + end_dir * EndPin->ArrowSize;
-            const auto min = p0.cwise_min(p1);
-            const auto max = p0.cwise_max(p1);
-            auto arrowBounds = rectf(min, max);
-            arrowBounds.w = std::max(arrowBounds.w, 1.0f);
-            arrowBounds.h = std::max(arrowBounds.h, 1.0f);
-            bounds = make_union(bounds, arrowBounds);
-        }
-
-        return bounds;
-    }
-    else
-        return ax::rectf();
+    return IsLive() ? Bounds : ax::rectf();
 }
 
 
@@ -781,18 +1054,48 @@ ax::rectf ed::Link::GetBounds() const
 ed::EditorContext::EditorContext(const ax::NodeEditor::Config* config):
     IsFirstFrame(true),
     IsWindowActive(false),
+    FrameIndex(0),
     ShortcutsEnabled(true),
     Style(),
+    NodePool(),
+    PinPool(),
+    LinkPool(),
     Nodes(),
     Pins(),
     Links(),
+    ObjectIndex(),
+    NodeGrid(),
+    LinkGrid(),
+    SortedPinCount(0),
+    SortedLinkCount(0),
+    SubmittedLinks(),
+    LastSubmittedLinks(),
+    SubmittedGroups(),
+    LastSubmittedGroups(),
+    DirtyGroupParents(),
+    DirtyGroupContents(),
+    ZOrderGroups(),
+    ZOrderBack(nullptr),
+    ZOrderFront(nullptr),
+    NextZOrder(0),
+    DirtyZOrder(),
     SelectionId(1),
     LastActiveLink(nullptr),
+    LastActiveObject(nullptr),
+    SceneVersion(1),
+    LiveObjectCount(0),
+    LastLiveObjectCount(0),
+    PickSceneVersion(0),
+    PickMousePos(0, 0),
+    PickedObject(nullptr),
+    PickedLink(nullptr),
     MousePosBackup(0, 0),
     MousePosPrevBackup(0, 0),
     MouseClickPosBackup(),
     Canvas(),
     SuspendCount(0),
+    ScreenSpaceCount(1),
+    ScreenSpaceChannel(0),
     NodeBuilder(this),
     HintBuilder(this),
     CurrentAction(nullptr),
@@ -822,9 +1125,9 @@ ed::EditorContext::~EditorContext()
     if (IsInitialized)
         SaveSettings();
 
-    for (auto link  : Links)  delete link.Object;
-    for (auto pin   : Pins)   delete pin.Object;
-    for (auto node  : Nodes)  delete node.Object;
+    for (auto link  : Links)  LinkPool.Destroy(link.Object);
+    for (auto pin   : Pins)   PinPool.Destroy(pin.Object);
+    for (auto node  : Nodes)  NodePool.Destroy(node.Object);
 }
 
 void ed::EditorContext::Begin(const char* id, const ImVec2& size)
@@ -838,9 +1141,16 @@ void ed::EditorContext::Begin(const char* id, const ImVec2& size)
     //ImGui::LogToClipboard();
     //Log("---- begin ----");
 
-    for (auto node  : Nodes)   node->Reset();
-    for (auto pin   : Pins)     pin->Reset();
-    for (auto link  : Links)   link->Reset();
+    ++FrameIndex;
+
+    std::swap(SubmittedLinks, LastSubmittedLinks);
+    SubmittedLinks.resize(0);
+
+    std::swap(SubmittedGroups, LastSubmittedGroups);
+    SubmittedGroups.resize(0);
+
+    LastLiveObjectCount = LiveObjectCount;
+    LiveObjectCount     = 0;
 
     ImGui::PushStyleColor(ImGuiCol_ChildWindowBg, ImColor(0, 0, 0, 0));
     ImGui::BeginChild(id, size, false,
@@ -883,8 +1193,9 @@ void ed::EditorContext::Begin(const char* id, const ImVec2& size)
     //drawList2->AddRect(Canvas.FromClient(ImVec2(0, 0)), Canvas.FromClient(ImVec2(0, 0)) + Canvas.ClientSize, IM_COL32(255, 0, 255, 255), 0, 15, 4.0f);
     //drawList2->PopClipRect();
 
-    auto clipMin = Canvas.FromScreen(Canvas.WindowScreenPos);
-    auto clipMax = Canvas.FromScreen(Canvas.WindowScreenPos) + Canvas.ClientSize;
+    // Clip to visible part of canvas inside of the border
+    auto clipMin = Canvas.FromScreen(Canvas.WindowScreenPos + ImVec2(1, 1));
+    auto clipMax = Canvas.FromScreen(Canvas.WindowScreenPos + Canvas.WindowScreenSize - ImVec2(1, 1));
 
     // #debug #clip
     //ImGui::Text("CLIP = { x=%g y=%g w=%g h=%g r=%g b=%g }",
@@ -894,9 +1205,13 @@ void ed::EditorContext::Begin(const char* id, const ImVec2& size)
 
     CaptureMouse();
 
-    // Reserve channels for background and links
+    // Canvas content is transformed to screen while being drawn
+    EnterCanvasSpace();
+
+    // Reserve channels for background, links and nodes
     auto drawList = ImGui::GetWindowDrawList();
-    ImDrawList_ChannelsGrow(drawList, c_NodeStartChannel);
+    ImDrawList_ChannelsGrow(drawList, c_NodeStartChannel + c_NodeChannelCount);
+    NodeDrawSegments.clear();
 
     if (HasSelectionChanged())
         ++SelectionId;
@@ -906,6 +1221,18 @@ void ed::EditorContext::Begin(const char* id, const ImVec2& size)
 
 void ed::EditorContext::End()
 {
+    MergeNewObjects();
+
+    // Groups which are no longer submitted release nodes they contained
+    for (auto group : LastSubmittedGroups)
+    {
+        if (!group->IsLive() && group->IsGroupLive)
+        {
+            group->IsGroupLive = false;
+            MarkGroupContentDirty(group);
+        }
+    }
+
     auto& io          = ImGui::GetIO();
     auto  control     = BuildControl(CurrentAction && CurrentAction->IsDragging()  /*NavigateAction.IsMovingOverEdge()*/);
     auto  drawList    = ImGui::GetWindowDrawList();
@@ -926,15 +1253,21 @@ void ed::EditorContext::End()
     const bool isDragging  = CurrentAction && CurrentAction->AsDrag()   != nullptr;
     const bool isSizing    = CurrentAction && CurrentAction->AsSize()   != nullptr;
 
-    // Draw nodes
-    for (auto node : Nodes)
-        if (node->IsLive && node->IsVisible())
-            node->Draw(drawList);
+    const auto& clipRect    = drawList->_ClipRectStack.back();
+    const auto  visibleRect = rectf(clipRect.x, clipRect.y, clipRect.z - clipRect.x, clipRect.w - clipRect.y);
+
+    // Cull live nodes and links, drawing code below reads the result
+    // through Object::IsVisible()
+    NodeVisibility.Cull(visibleRect, FrameIndex);
+    LinkVisibility.Cull(visibleRect, FrameIndex);
+
+    // Draw nodes, primitives are put in node order when merged, so order does not matter
+    for (auto node : NodeVisibility.GetVisibleObjects())
+        node->Draw(drawList);
 
     // Draw links
-    for (auto link : Links)
-        if (link->IsLive && link->IsVisible())
-            link->Draw(drawList);
+    for (auto link : LinkVisibility.GetVisibleObjects())
+        link->Draw(drawList);
 
     // Highlight selected objects
     {
@@ -1017,86 +1350,32 @@ void ed::EditorContext::End()
     // Draw selection rectangle
     SelectAction.Draw(drawList);
 
-    bool sortGroups = false;
     if (control.ActiveNode)
     {
         if (!IsGroup(control.ActiveNode))
         {
             // Bring active node to front
-            auto activeNodeIt = std::find(Nodes.begin(), Nodes.end(), control.ActiveNode);
-            std::rotate(activeNodeIt, activeNodeIt + 1, Nodes.end());
+            RaiseNode(control.ActiveNode);
         }
         else if (!isDragging && CurrentAction && CurrentAction->AsDrag())
         {
-            // Bring content of dragged group to front
+            // Bring content of dragged group to front, keeping its order
             std::vector<Node*> nodes;
             control.ActiveNode->GetGroupedNodes(nodes);
+            std::sort(nodes.begin(), nodes.end(), [](Node* lhs, Node* rhs) { return lhs->ZOrder < rhs->ZOrder; });
 
-            std::stable_partition(Nodes.begin(), Nodes.end(), [&nodes](Node* node)
-            {
-                return std::find(nodes.begin(), nodes.end(), node) == nodes.end();
-            });
-
-            sortGroups = true;
+            for (auto node : nodes)
+                RaiseNode(node);
         }
     }
 
-    // Sort nodes if bounds of node changed
-    if (sortGroups || ((Settings.DirtyReason & (SaveReasonFlags::Position | SaveReasonFlags::Size)) != SaveReasonFlags::None))
-    {
-        // Bring all groups before regular nodes
-        auto groupsItEnd = std::stable_partition(Nodes.begin(), Nodes.end(), IsGroup);
-
-        // Sort groups by area
-        std::sort(Nodes.begin(), groupsItEnd, [this](Node* lhs, Node* rhs)
-        {
-            const auto& lhsSize = lhs == SizeAction.SizedNode ? SizeAction.GetStartGroupBounds().size : lhs->GroupBounds.size;
-            const auto& rhsSize = rhs == SizeAction.SizedNode ? SizeAction.GetStartGroupBounds().size : rhs->GroupBounds.size;
-
-            const auto lhsArea = lhsSize.w * lhsSize.h;
-            const auto rhsArea = rhsSize.w * rhsSize.h;
-
-            return lhsArea > rhsArea;
-        });
-    }
-
-    // Every node has few channels assigned. Grow channel list
-    // to hold twice as much of channels and place them in
-    // node drawing order.
-    {
-        // Copy group nodes
-        auto liveNodeCount = std::count_if(Nodes.begin(), Nodes.end(), [](Node* node) { return node->IsLive; });
+    // Move groups which area changed
+    UpdateGroupZOrder();
 
-        // Reserve two additional channels for sorted list of channels
-        auto nodeChannelCount = drawList->_ChannelsCount;
-        ImDrawList_ChannelsGrow(drawList, drawList->_ChannelsCount + c_ChannelsPerNode * liveNodeCount + c_LinkChannelCount);
+    // Put primitives recorded by nodes and links in drawing order
+    MergeNodeDrawLayers(drawList);
 
-        int targetChannel = nodeChannelCount;
-
-        auto copyNode = [&targetChannel, drawList](Node* node)
-        {
-            if (!node->IsLive)
-                return;
-
-            for (int i = 0; i < c_ChannelsPerNode; ++i)
-                ImDrawList_SwapChannels(drawList, node->Channel + i, targetChannel + i);
-
-            node->Channel = targetChannel;
-            targetChannel += c_ChannelsPerNode;
-        };
-
-        auto groupsItEnd = std::find_if(Nodes.begin(), Nodes.end(), [](Node* node) { return !IsGroup(node); });
-
-        // Copy group nodes
-        std::for_each(Nodes.begin(), groupsItEnd, copyNode);
-
-        // Copy links
-        for (int i = 0; i < c_LinkChannelCount; ++i, ++targetChannel)
-            ImDrawList_SwapChannels(drawList, c_LinkStartChannel + i, targetChannel);
-
-        // Copy normal nodes
-        std::for_each(groupsItEnd, Nodes.end(), copyNode);
-    }
+    LeaveCanvasSpace();
 
     ImGui::PopClipRect();
 
@@ -1108,19 +1387,14 @@ void ed::EditorContext::End()
 
         ImGui::PushClipRect(Canvas.WindowScreenPos + ImVec2(1, 1), Canvas.WindowScreenPos + Canvas.WindowScreenSize - ImVec2(1, 1), false);
 
-        ImVec2 offset    = Canvas.ClientOrigin;
-        ImU32 GRID_COLOR = GetColor(StyleColor_Grid);
-        float GRID_SX    = 32.0f * Canvas.Zoom.x;
-        float GRID_SY    = 32.0f * Canvas.Zoom.y;
-        ImVec2 win_pos   = Canvas.WindowScreenPos;
-        ImVec2 canvas_sz = Canvas.WindowScreenSize;
-
         drawList->AddRectFilled(Canvas.WindowScreenPos, Canvas.WindowScreenPos + Canvas.WindowScreenSize, GetColor(StyleColor_Bg), style.WindowRounding);
 
-        for (float x = fmodf(offset.x, GRID_SX); x < Canvas.WindowScreenSize.x; x += GRID_SX)
-            drawList->AddLine(ImVec2(x, 0.0f) + Canvas.WindowScreenPos, ImVec2(x, Canvas.WindowScreenSize.y) + Canvas.WindowScreenPos, GRID_COLOR);
-        for (float y = fmodf(offset.y, GRID_SY); y < Canvas.WindowScreenSize.y; y += GRID_SY)
-            drawList->AddLine(ImVec2(0.0f, y) + Canvas.WindowScreenPos, ImVec2(Canvas.WindowScreenSize.x, y) + Canvas.WindowScreenPos, GRID_COLOR);
+        ImDrawList_AddGrid(drawList,
+            Canvas.WindowScreenPos,
+            Canvas.WindowScreenPos + Canvas.WindowScreenSize,
+            Canvas.WindowScreenPos + Canvas.ClientOrigin,
+            Canvas.Zoom,
+            GetColor(StyleColor_Grid));
 
         ImGui::PopClipRect();
     }
@@ -1133,27 +1407,6 @@ void ed::EditorContext::End()
             ImDrawList_SwapChannels(drawList, userChannel + i, c_UserLayerChannelStart + i);
     }
 
-    {
-        auto preOffset  = ImVec2(0, 0);
-        auto postOffset = Canvas.WindowScreenPos + Canvas.ClientOrigin;
-        auto scale      = Canvas.Zoom;
-
-        ImDrawList_TransformChannels(drawList,                        0,                            1, preOffset, scale, postOffset);
-        ImDrawList_TransformChannels(drawList, c_BackgroundChannelStart, drawList->_ChannelsCount - 1, preOffset, scale, postOffset);
-
-        auto clipTranslation = Canvas.WindowScreenPos - Canvas.FromScreen(Canvas.WindowScreenPos);
-        ImGui::PushClipRect(Canvas.WindowScreenPos + ImVec2(1, 1), Canvas.WindowScreenPos + Canvas.WindowScreenSize - ImVec2(1, 1), false);
-        ImDrawList_TranslateAndClampClipRects(drawList,                        0,                            1, clipTranslation);
-        ImDrawList_TranslateAndClampClipRects(drawList, c_BackgroundChannelStart, drawList->_ChannelsCount - 1, clipTranslation);
-        ImGui::PopClipRect();
-
-        // #debug: Static grid in local space
-        //for (float x = 0; x < Canvas.WindowScreenSize.x; x += 100)
-        //    drawList->AddLine(ImVec2(x, 0.0f) + Canvas.WindowScreenPos, ImVec2(x, Canvas.WindowScreenSize.y) + Canvas.WindowScreenPos, IM_COL32(255, 0, 0, 128));
-        //for (float y = 0; y < Canvas.WindowScreenSize.y; y += 100)
-        //    drawList->AddLine(ImVec2(0.0f, y) + Canvas.WindowScreenPos, ImVec2(Canvas.WindowScreenSize.x, y) + Canvas.WindowScreenPos, IM_COL32(255, 0, 0, 128));
-    }
-
     // Move hint channels to top
     {
         auto channelCount = drawList->_ChannelsCount;
@@ -1189,7 +1442,7 @@ void ed::EditorContext::End()
     if (!CurrentAction && IsFirstFrame && !Settings.Selection.empty())
     {
         ClearSelection();
-        for (int id : Settings.Selection)
+        for (ObjectId id : Settings.Selection)
             if (auto object = FindObject(id))
                 SelectObject(object);
     }
@@ -1200,52 +1453,110 @@ void ed::EditorContext::End()
     if (Settings.IsDirty && !CurrentAction)
         SaveSettings();
 
+    // Objects are released only between actions, none of them
+    // holds pointers to objects at that point.
+    if (Config.ReclaimAfterFrames > 0 && !CurrentAction)
+        ReclaimDeadObjects();
+
     IsFirstFrame = false;
 }
 
-bool ed::EditorContext::DoLink(int id, int startPinId, int endPinId, ImU32 color, float thickness)
+bool ed::EditorContext::DoLink(ObjectId id, ObjectId startPinId, ObjectId endPinId, ImU32 color, float thickness)
 {
-    auto& editorStyle = GetStyle();
+    // Links are usually submitted in the same order every frame. Try link
+    // submitted at the same position in previous frame before lookup.
+    Link* link = nullptr;
+    const auto submissionIndex = SubmittedLinks.size();
+    if (submissionIndex < LastSubmittedLinks.size() && LastSubmittedLinks[submissionIndex]->ID == id)
+        link = LastSubmittedLinks[submissionIndex];
+    else
+        link = FindLink(id);
 
-    auto startPin = FindPin(startPinId);
-    auto endPin   = FindPin(endPinId);
+    // Link is never reclaimed after its pins, so pins it remembers are valid.
+    Pin* startPin = nullptr;
+    Pin* endPin   = nullptr;
+    if (link && link->StartPin && link->StartPin->ID == startPinId && link->EndPin->ID == endPinId)
+    {
+        startPin = link->StartPin;
+        endPin   = link->EndPin;
+    }
+    else
+    {
+        startPin = FindPin(startPinId);
+        endPin   = FindPin(endPinId);
+    }
 
-    if (!startPin || !startPin->IsLive || !endPin || !endPin->IsLive)
+    if (!startPin || !startPin->IsLive() || !endPin || !endPin->IsLive())
         return false;
 
-    startPin->HasConnection = true;
-      endPin->HasConnection = true;
+    startPin->ConnectionFrame = FrameIndex;
+      endPin->ConnectionFrame = FrameIndex;
+
+    if (!link)
+        link = CreateLink(id);
+
+    const auto isGeometryDirty =
+        link->StartPin != startPin || link->StartPinVersion != startPin->Version ||
+        link->EndPin   != endPin   || link->EndPinVersion   != endPin->Version;
+    const auto isThicknessDirty = link->Thickness != thickness;
+
+    // Pins changed or link was detached by them while it was not submitted
+    if (link->StartPin != startPin || link->EndPin != endPin || !link->IsAttached)
+        link->AttachPins(startPin, endPin);
+
+    if (isGeometryDirty)
+    {
+        link->StartPinVersion = startPin->Version;
+        link->EndPinVersion   = endPin->Version;
 
-    auto link           = GetLink(id);
-    link->StartPin      = startPin;
-    link->EndPin        = endPin;
-    link->Color         = color;
-    link->Thickness     = thickness;
-    link->IsLive        = true;
+        link->UpdateEndpoints();
+        link->UpdateGeometry();
 
-    link->UpdateEndpoints();
+        LinkVisibility.Update(link->VisibilitySlot, link->Bounds);
+
+        NotifySceneChanged();
+    }
+
+    if (isThicknessDirty)
+        NotifySceneChanged();
+
+    link->Color     = color;
+    link->Thickness = thickness;
+
+    // Link is picked up to its pick distance outside of bounds, it is
+    // registered in cells cursor can pick it from, see FindLinkAt()
+    if (isGeometryDirty || isThicknessDirty)
+    {
+        auto gridBounds = link->Bounds;
+        gridBounds.expand(link->Thickness + c_LinkSelectThickness);
+        LinkGrid.Update(link, gridBounds);
+    }
+
+    link->MarkLive();
+
+    SubmittedLinks.push_back(link);
 
     return true;
 }
 
-void ed::EditorContext::SetNodePosition(int nodeId, const ImVec2& position)
+void ed::EditorContext::SetNodePosition(ObjectId nodeId, const ImVec2& position)
 {
     auto node = FindNode(nodeId);
     if (!node)
     {
         node = CreateNode(nodeId);
-        node->IsLive = false;
     }
 
     auto newPosition = to_point(position);
     if (node->Bounds.location != newPosition)
     {
         node->Bounds.location = to_point(position);
+        NotifyNodeBoundsChanged(node);
         MakeDirty(NodeEditor::SaveReasonFlags::Position, node);
     }
 }
 
-ImVec2 ed::EditorContext::GetNodePosition(int nodeId)
+ImVec2 ed::EditorContext::GetNodePosition(ObjectId nodeId)
 {
     auto node = FindNode(nodeId);
     if (!node)
@@ -1254,7 +1565,7 @@ ImVec2 ed::EditorContext::GetNodePosition(int nodeId)
     return to_imvec(node->Bounds.location);
 }
 
-ImVec2 ed::EditorContext::GetNodeSize(int nodeId)
+ImVec2 ed::EditorContext::GetNodeSize(ObjectId nodeId)
 {
     auto node = FindNode(nodeId);
     if (!node)
@@ -1330,7 +1641,7 @@ const ed::vector<ed::Object*>& ed::EditorContext::GetSelectedObjects()
 bool ed::EditorContext::IsAnyNodeSelected()
 {
     for (auto object : SelectedObjects)
-        if (object->AsNode())
+        if (object->IsNode())
             return true;
 
     return false;
@@ -1339,7 +1650,7 @@ bool ed::EditorContext::IsAnyNodeSelected()
 bool ed::EditorContext::IsAnyLinkSelected()
 {
     for (auto object : SelectedObjects)
-        if (object->AsLink())
+        if (object->IsLink())
             return true;
 
     return false;
@@ -1352,11 +1663,16 @@ bool ed::EditorContext::HasSelectionChanged()
 
 ed::Node* ed::EditorContext::FindNodeAt(const ImVec2& p)
 {
-    for (auto node : Nodes)
-        if (node->TestHit(p))
-            return node;
+    vector<Node*> candidates;
+    NodeGrid.Query(rectf(to_pointf(p), sizef(0, 0)), candidates);
 
-    return nullptr;
+    // First hit in node order wins
+    Node* result = nullptr;
+    for (auto node : candidates)
+        if ((!result || node->ZOrder < result->ZOrder) && node->TestHit(p))
+            result = node;
+
+    return result;
 }
 
 void ed::EditorContext::FindNodesInRect(const ax::rectf& r, vector<Node*>& result, bool append, bool includeIntersecting)
@@ -1367,9 +1683,17 @@ void ed::EditorContext::FindNodesInRect(const ax::rectf& r, vector<Node*>& resul
     if (r.is_empty())
         return;
 
-    for (auto node : Nodes)
-        if (node->TestHit(r, includeIntersecting))
-            result.push_back(node);
+    const auto firstIndex = result.size();
+
+    NodeGrid.Query(r, result);
+
+    result.erase(std::remove_if(result.begin() + firstIndex, result.end(), [&r, includeIntersecting](Node* node)
+    {
+        return !node->TestHit(r, includeIntersecting);
+    }), result.end());
+
+    // Report nodes in node order
+    std::sort(result.begin() + firstIndex, result.end(), [](Node* lhs, Node* rhs) { return lhs->ZOrder < rhs->ZOrder; });
 }
 
 void ed::EditorContext::FindLinksInRect(const ax::rectf& r, vector<Link*>& result, bool append)
@@ -1382,33 +1706,259 @@ void ed::EditorContext::FindLinksInRect(const ax::rectf& r, vector<Link*>& resul
     if (r.is_empty())
         return;
 
-    for (auto link : Links)
-        if (link->TestHit(r))
+    const auto firstIndex = result.size();
+
+    vector<Link*> candidates;
+    LinkGrid.Query(r, candidates);
+
+    // Same test as Link::TestHit, but curves crossing rectangle edges
+    // are tested in one batch
+    vector<Link*>          crossing;
+    vector<cubic_bezier_t> curves;
+    for (auto link : candidates)
+    {
+        if (!link->IsLive())
+            continue;
+
+        const auto bounds = link->GetBounds();
+        if (r.contains(bounds))
             result.push_back(link);
+        else if (r.intersects(bounds))
+        {
+            crossing.push_back(link);
+            curves.push_back(link->GetCurve());
+        }
+    }
+
+    if (!curves.empty())
+    {
+        vector<int> hits(curves.size());
+        cubic_bezier_rect_intersect(curves.data(), static_cast<int>(curves.size()), r, hits.data());
+
+        for (size_t i = 0; i < crossing.size(); ++i)
+            if (hits[i])
+                result.push_back(crossing[i]);
+    }
+
+    // Report links in link order
+    std::sort(result.begin() + firstIndex, result.end(), [](Link* lhs, Link* rhs) { return lhs->ID < rhs->ID; });
 }
 
-void ed::EditorContext::FindLinksForNode(int nodeId, vector<Link*>& result, bool add)
+void ed::EditorContext::FindLinksForNode(ObjectId nodeId, vector<Link*>& result, bool add)
 {
     if (!add)
         result.clear();
 
-    for (auto link : Links)
+    auto node = FindNode(nodeId);
+    if (!node || !node->IsLive())
+        return;
+
+    // Live link has live pins, so it can be reached from pins of the node.
+    // Link between two pins of the node is taken from its start pin only.
+    for (auto pin = node->LastPin; pin; pin = pin->PreviousPin)
     {
-        if (!link->IsLive)
-            continue;
+        for (auto link : pin->Links)
+        {
+            if (!link->IsLive())
+                continue;
+
+            if (link->StartPin != pin && link->StartPin->Node == node)
+                continue;
 
-        if (link->StartPin->Node->ID == nodeId || link->EndPin->Node->ID == nodeId)
             result.push_back(link);
+        }
     }
 }
 
-bool ed::EditorContext::PinHadAnyLinks(int pinId)
+void ed::EditorContext::FindLinksForPin(ObjectId pinId, vector<Link*>& result, bool add)
+{
+    if (!add)
+        result.clear();
+
+    auto pin = FindPin(pinId);
+    if (!pin || !pin->IsLive())
+        return;
+
+    for (auto link : pin->Links)
+        if (link->IsLive())
+            result.push_back(link);
+}
+
+bool ed::EditorContext::PinHadAnyLinks(ObjectId pinId)
 {
     auto pin = FindPin(pinId);
-    if (!pin || !pin->IsLive)
+    if (!pin || !pin->IsLive())
         return false;
 
-    return pin->HasConnection || pin->HadConnection;
+    // Pin was connected in this or previous frame
+    return pin->ConnectionFrame >= FrameIndex - 1;
+}
+
+void ed::EditorContext::NotifyNodeBoundsChanged(Node* node)
+{
+    NodeGrid.Update(node, node->GetBounds());
+
+    auto isSameRect = [](const rect& lhs, const rect& rhs)
+    {
+        return lhs.x == rhs.x && lhs.y == rhs.y && lhs.w == rhs.w && lhs.h == rhs.h;
+    };
+
+    if (!isSameRect(node->SceneBounds, node->Bounds) || !isSameRect(node->SceneGroupBounds, node->GroupBounds) || node->SceneType != node->Type)
+    {
+        MarkGroupParentDirty(node);
+        NodeVisibility.Update(node->VisibilitySlot, node->GetBounds());
+
+        // Group area changed, nodes may enter or leave it
+        if (node->Type == NodeType::Group || node->SceneType == NodeType::Group)
+            MarkGroupContentDirty(node);
+
+        // Group moves in group order when its area changes, node becoming
+        // a group or back moves between orders
+        const auto isGroup = node->Type == NodeType::Group;
+        if ((isGroup != (node->GroupArea >= 0) || (isGroup && node->GroupArea != node->GroupBounds.w * node->GroupBounds.h)) && !node->IsZOrderDirty)
+        {
+            node->IsZOrderDirty = true;
+            DirtyZOrder.push_back(node);
+        }
+
+        node->SceneBounds      = node->Bounds;
+        node->SceneGroupBounds = node->GroupBounds;
+        node->SceneType        = node->Type;
+        NotifySceneChanged();
+    }
+}
+
+void ed::EditorContext::MarkGroupParentDirty(Node* node)
+{
+    if (node->IsGroupParentDirty)
+        return;
+
+    node->IsGroupParentDirty = true;
+    DirtyGroupParents.push_back(node);
+}
+
+void ed::EditorContext::MarkGroupContentDirty(Node* group)
+{
+    if (group->IsGroupContentDirty)
+        return;
+
+    group->IsGroupContentDirty = true;
+    DirtyGroupContents.push_back(group);
+}
+
+void ed::EditorContext::NotifyGroupSubmitted(Node* group)
+{
+    SubmittedGroups.push_back(group);
+
+    // Group held no nodes while it was not submitted
+    if (!group->IsGroupLive)
+    {
+        group->IsGroupLive = true;
+        MarkGroupContentDirty(group);
+    }
+}
+
+void ed::EditorContext::SetGroupParent(Node* node, Node* parent)
+{
+    if (node->GroupParent == parent)
+        return;
+
+    if (auto oldParent = node->GroupParent)
+    {
+        auto& children = oldParent->GroupChildren;
+        auto it = std::find(children.begin(), children.end(), node);
+        assert(it != children.end());
+        *it = children.back();
+        children.pop_back();
+    }
+
+    node->GroupParent = parent;
+
+    if (parent)
+        parent->GroupChildren.push_back(node);
+}
+
+ed::Node* ed::EditorContext::FindGroupParent(Node* node)
+{
+    const auto bounds = static_cast<rectf>(node->Bounds);
+    if (bounds.is_empty())
+        return nullptr;
+
+    vector<Node*> candidates;
+    NodeGrid.Query(bounds, candidates);
+
+    // Group must be strictly larger than the node, this keeps
+    // hierarchy free of cycles when bounds are equal. Groups not
+    // submitted anymore are skipped, IsGroupLive is used instead of
+    // IsLive() to not drop groups yet to be submitted in current frame.
+    const auto area = static_cast<int64_t>(node->Bounds.w) * node->Bounds.h;
+
+    Node*   parent     = nullptr;
+    int64_t parentArea = 0;
+    for (auto candidate : candidates)
+    {
+        if (candidate == node || candidate->Type != NodeType::Group || !candidate->IsGroupLive)
+            continue;
+
+        const auto candidateArea = static_cast<int64_t>(candidate->Bounds.w) * candidate->Bounds.h;
+        if (candidateArea <= area || (parent && candidateArea >= parentArea))
+            continue;
+
+        const auto groupBounds = static_cast<rectf>(candidate->GroupBounds);
+        if (groupBounds.is_empty() || !groupBounds.contains(bounds))
+            continue;
+
+        parent     = candidate;
+        parentArea = candidateArea;
+    }
+
+    return parent;
+}
+
+void ed::EditorContext::UpdateGroupHierarchy()
+{
+    // Node can change group only when it moved itself, or when area of
+    // group it was in or it is in now changed.
+    vector<Node*> nodes;
+    for (auto group : DirtyGroupContents)
+    {
+        for (auto child : group->GroupChildren)
+            MarkGroupParentDirty(child);
+
+        if (group->Type == NodeType::Group && !group->GroupBounds.is_empty())
+        {
+            NodeGrid.Query(static_cast<rectf>(group->GroupBounds), nodes);
+            for (auto node : nodes)
+                MarkGroupParentDirty(node);
+            nodes.resize(0);
+        }
+
+        group->IsGroupContentDirty = false;
+    }
+    DirtyGroupContents.resize(0);
+
+    for (auto node : DirtyGroupParents)
+    {
+        SetGroupParent(node, FindGroupParent(node));
+        node->IsGroupParentDirty = false;
+    }
+    DirtyGroupParents.resize(0);
+}
+
+void ed::EditorContext::FindGroupChildren(ObjectId nodeId, vector<Node*>& result, bool add)
+{
+    if (!add)
+        result.clear();
+
+    auto node = FindNode(nodeId);
+    if (!node || !IsGroup(node))
+        return;
+
+    UpdateGroupHierarchy();
+
+    for (auto child : node->GroupChildren)
+        if (child->IsLive())
+            result.push_back(child);
 }
 
 void ed::EditorContext::NotifyLinkDeleted(Link* link)
@@ -1421,7 +1971,10 @@ void ed::EditorContext::Suspend()
 {
     //assert(!IsSuspended);
     if (0 == SuspendCount++)
+    {
         ReleaseMouse();
+        LeaveCanvasSpace();
+    }
 }
 
 void ed::EditorContext::Resume()
@@ -1429,7 +1982,43 @@ void ed::EditorContext::Resume()
     assert(SuspendCount > 0);
 
     if (0 == --SuspendCount)
+    {
         CaptureMouse();
+        EnterCanvasSpace();
+    }
+}
+
+void ed::EditorContext::LeaveCanvasSpace()
+{
+    if (0 == ScreenSpaceCount++)
+    {
+        auto drawList = ImGui::GetWindowDrawList();
+        ScreenSpaceChannel = drawList->_ChannelsCurrent;
+        drawList->PopTransformation();
+    }
+}
+
+void ed::EditorContext::EnterCanvasSpace()
+{
+    assert(ScreenSpaceCount > 0);
+
+    if (0 == --ScreenSpaceCount)
+    {
+        const auto offset = Canvas.WindowScreenPos + Canvas.ClientOrigin;
+
+        auto drawList = ImGui::GetWindowDrawList();
+        drawList->PushTransformation(ImMatrix(Canvas.Zoom.x, 0.0f, 0.0f, Canvas.Zoom.y, offset.x, offset.y), false);
+
+        // Clip rect of channel which was current when canvas space was left
+        // may be updated in screen space, bring it back
+        auto currentChannel = drawList->_ChannelsCurrent;
+        if (ScreenSpaceChannel != currentChannel && ScreenSpaceChannel < drawList->_ChannelsCount)
+        {
+            drawList->ChannelsSetCurrent(ScreenSpaceChannel);
+            drawList->UpdateClipRect();
+            drawList->ChannelsSetCurrent(currentChannel);
+        }
+    }
 }
 
 bool ed::EditorContext::IsSuspended()
@@ -1442,20 +2031,25 @@ bool ed::EditorContext::IsActive()
     return IsWindowActive;
 }
 
-ed::Pin* ed::EditorContext::CreatePin(int id, PinKind kind)
+ed::Pin* ed::EditorContext::CreatePin(ObjectId id, PinKind kind)
 {
     assert(nullptr == FindObject(id));
-    auto pin = new Pin(this, id, kind);
+    auto pin = PinPool.Create(this, id, kind);
+    pin->CreationFrame = FrameIndex;
     Pins.push_back({id, pin});
-    std::sort(Pins.begin(), Pins.end());
+    ObjectIndex.Insert(id, pin);
     return pin;
 }
 
-ed::Node* ed::EditorContext::CreateNode(int id)
+ed::Node* ed::EditorContext::CreateNode(ObjectId id)
 {
     assert(nullptr == FindObject(id));
-    auto node = new Node(this, id);
+    auto node = NodePool.Create(this, id);
+    node->CreationFrame = FrameIndex;
     Nodes.push_back({id, node});
+    LinkNodeZOrder(node);
+    node->VisibilitySlot = NodeVisibility.Add(node, node->GetBounds());
+    ObjectIndex.Insert(id, node);
     //std::sort(Nodes.begin(), Nodes.end());
 
     auto settings = Settings.FindNode(id);
@@ -1476,90 +2070,64 @@ ed::Node* ed::EditorContext::CreateNode(int id)
         node->GroupBounds.size = to_size(settings->GroupSize);
     }
 
-    node->IsLive = false;
-
     return node;
 }
 
-ed::Link* ed::EditorContext::CreateLink(int id)
+ed::Link* ed::EditorContext::CreateLink(ObjectId id)
 {
     assert(nullptr == FindObject(id));
-    auto link = new Link(this, id);
+    auto link = LinkPool.Create(this, id);
+    link->CreationFrame = FrameIndex;
     Links.push_back({id, link});
-    std::sort(Links.begin(), Links.end());
+    ObjectIndex.Insert(id, link);
+    link->VisibilitySlot = LinkVisibility.Add(link, link->Bounds);
 
     return link;
 }
 
-ed::Object* ed::EditorContext::FindObject(int id)
+template <typename T>
+static void MergeSortedTail(std::vector<ed::ObjectWrapper<T>>& objects, size_t& sortedCount)
 {
-    if (auto object = FindNode(id))
-        return object;
-    if (auto object = FindPin(id))
-        return object;
-    if (auto object = FindLink(id))
-        return object;
-    return nullptr;
+    if (sortedCount == objects.size())
+        return;
+
+    auto middle = objects.begin() + sortedCount;
+    std::sort(middle, objects.end());
+    std::inplace_merge(objects.begin(), middle, objects.end());
+
+    sortedCount = objects.size();
 }
 
-template <typename C>
-static inline auto FindItemInLinear(C& container, int id)
+void ed::EditorContext::MergeNewObjects()
 {
-# if defined(_DEBUG)
-    auto start = container.data();
-    auto end   = container.data() + container.size();
-    for (auto it = start; it < end; ++it)
-        if ((*it).ID == id)
-            return it->Object;
-# else
-    for (auto item : container)
-        if (item.ID == id)
-            return item.Object;
-# endif
+    // Objects created during the frame are appended, lookup goes through
+    // ObjectIndex so they are reachable immediately. Sorted order is needed
+    // only for iteration, so new objects are merged in a single pass.
+    MergeSortedTail(Pins,  SortedPinCount);
+    MergeSortedTail(Links, SortedLinkCount);
+}
 
-   return static_cast<decltype(container[0].Object)>(nullptr);
-}
-
-template <typename C>
-static inline auto FindItemIn(C& container, int id)
-{
-//# if defined(_DEBUG)
-//    auto start = container.data();
-//    auto end   = container.data() + container.size();
-//    for (auto it = start; it < end; ++it)
-//        if ((*it)->ID == id)
-//            return *it;
-//# else
-//    for (auto item : container)
-//        if (item->ID == id)
-//            return item;
-//# endif
-    auto key = C::value_type{ id, nullptr };
-    auto first = container.cbegin();
-    auto last  = container.cend();
-    auto it    = std::lower_bound(first, last, key);
-    if (it != last && (key.ID == it->ID))
-        return it->Object;
-    else
-        return static_cast<decltype(it->Object)>(nullptr);
+ed::Object* ed::EditorContext::FindObject(ObjectId id)
+{
+    return ObjectIndex.Find(id);
 }
 
-ed::Node* ed::EditorContext::FindNode(int id)
+ed::Node* ed::EditorContext::FindNode(ObjectId id)
 {
-    return FindItemInLinear(Nodes, id);
+    return static_cast<Node*>(ObjectIndex.Find(id, ObjectType::Node));
 }
 
-ed::Pin* ed::EditorContext::FindPin(int id)
+ed::Pin* ed::EditorContext::FindPin(ObjectId id)
 {
-    return FindItemIn(Pins, id);
+    return static_cast<Pin*>(ObjectIndex.Find(id, ObjectType::Pin));
 }
 
-ed::Link* ed::EditorContext::FindLink(int id)
+ed::Link* ed::EditorContext::FindLink(ObjectId id)
 {
-    return FindItemIn(Links, id);
+    return static_cast<Link*>(ObjectIndex.Find(id, ObjectType::Link));
 }
 
-ed::Node* ed::EditorContext::GetNode(int id)
+ed::Node* ed::EditorContext::GetNode(ObjectId id)
 {
     auto node = FindNode(id);
     if (!node)
@@ -1567,7 +2135,7 @@ ed::Node* ed::EditorContext::GetNode(int id)
     return node;
 }
 
-ed::Pin* ed::EditorContext::GetPin(int id, PinKind kind)
+ed::Pin* ed::EditorContext::GetPin(ObjectId id, PinKind kind)
 {
     if (auto pin = FindPin(id))
     {
@@ -1578,7 +2146,7 @@ ed::Pin* ed::EditorContext::GetPin(int id, PinKind kind)
         return CreatePin(id, kind);
 }
 
-ed::Link* ed::EditorContext::GetLink(int id)
+ed::Link* ed::EditorContext::GetLink(ObjectId id)
 {
     if (auto link = FindLink(id))
         return link;
@@ -1620,25 +2188,120 @@ void ed::EditorContext::SaveSettings()
     Settings.ViewScroll = NavigateAction.Scroll;
     Settings.ViewZoom   = NavigateAction.Zoom;
 
-    if (Config.Save(Settings.Serialize(), Settings.DirtyReason))
-        Settings.ClearDirty();
+    if (Config.Save(Settings.Serialize(), Settings.DirtyReason))
+        Settings.ClearDirty();
+
+    Config.EndSave();
+}
+
+void ed::EditorContext::MakeDirty(SaveReasonFlags reason)
+{
+    Settings.MakeDirty(reason);
+}
+
+void ed::EditorContext::MakeDirty(SaveReasonFlags reason, Node* node)
+{
+    Settings.MakeDirty(reason, node);
+}
+
+ed::Object* ed::EditorContext::PickObjectAt(const ImVec2& position)
+{
+    // Same test ImGui use to hover items
+    const auto p = to_pointf(position);
+    auto contains = [&p](const rect& bounds) { return static_cast<rectf>(bounds).contains(p); };
+
+    vector<Node*> candidates;
+    NodeGrid.Query(rectf(p, sizef(0, 0)), candidates);
+
+    // Top-most node first
+    std::sort(candidates.begin(), candidates.end(), [](Node* lhs, Node* rhs) { return lhs->ZOrder > rhs->ZOrder; });
+
+    for (auto node : candidates)
+    {
+        if (!node->IsLive()) continue;
+
+        // Pins does not overlap each other and all are within node bounds,
+        // so they are found through node and take precedence over it.
+        for (auto pin = node->LastPin; pin; pin = pin->PreviousPin)
+            if (pin->IsLive() && contains(pin->Bounds))
+                return pin;
+
+        if (!contains(node->Bounds))
+            continue;
+
+        // Group is a node with a hole
+        if (node->Type == NodeType::Group && contains(node->GroupBounds))
+            continue;
+
+        return node;
+    }
 
-    Config.EndSave();
+    return nullptr;
 }
 
-void ed::EditorContext::MakeDirty(SaveReasonFlags reason)
+ax::rect ed::EditorContext::GetInteractiveArea(Object* object, const ImVec2& p)
 {
-    Settings.MakeDirty(reason);
-}
+    auto node = object->AsNode();
+    if (!node || node->Type != NodeType::Group)
+        return static_cast<rect>(object->GetBounds());
 
-void ed::EditorContext::MakeDirty(SaveReasonFlags reason, Node* node)
-{
-    Settings.MakeDirty(reason, node);
+    // Group can be pressed only on its frame, return part of the frame
+    // under the cursor or top part if cursor is over the hole.
+    const auto top    = node->GroupBounds.top()  - node->Bounds.top();
+    const auto left   = node->GroupBounds.left() - node->Bounds.left();
+    const auto bottom = node->Bounds.bottom()    - node->GroupBounds.bottom();
+    const auto right  = node->Bounds.right()     - node->GroupBounds.right();
+
+    const rect parts[] =
+    {
+        rect(node->Bounds.left(),  node->Bounds.top(),             node->Bounds.w, top),
+        rect(node->Bounds.left(),  node->Bounds.bottom() - bottom, node->Bounds.w, bottom),
+        rect(node->Bounds.left(),  node->Bounds.top() + top,       left, node->Bounds.h - top - bottom),
+        rect(node->Bounds.right() - right, node->Bounds.top() + top, right, node->Bounds.h - top - bottom)
+    };
+
+    for (auto& part : parts)
+        if (static_cast<rectf>(part).contains(to_pointf(p)))
+            return part;
+
+    return parts[0];
 }
 
 ed::Link* ed::EditorContext::FindLinkAt(const ax::point& p)
 {
-    for (auto& link : Links)
+    const auto point = to_pointf(p);
+
+    // Links are registered in grid with bounds grown by their pick distance,
+    // so link lying just across cell boundary from the point is still found.
+    vector<Link*> candidates;
+    LinkGrid.Query(rectf(point, sizef(0, 0)), candidates);
+
+    // Reject links by bounds and by distance to flattened curve first.
+    // Polyline stays within tessellation tolerance from the curve, so
+    // widening hit distance by that much never drops a link that would hit.
+    candidates.erase(std::remove_if(candidates.begin(), candidates.end(), [&point](Link* link)
+    {
+        if (!link->IsLive())
+            return true;
+
+        const auto maxDistance = link->Thickness + c_LinkSelectThickness;
+
+        auto bounds = link->Bounds;
+        bounds.expand(maxDistance);
+        if (!bounds.contains(point))
+            return true;
+
+        const auto& polyline = link->GetPolyline();
+        const auto  distance = maxDistance + c_LinkPolylineTolerance;
+
+        return !Polyline_IsPointNear(polyline.data(), static_cast<int>(polyline.size()), point, distance * distance);
+    }), candidates.end());
+
+    // Links are tested in ID order, as they were when all links were scanned.
+    // Precise projection is done only until first hit.
+    std::sort(candidates.begin(), candidates.end(), [](Link* lhs, Link* rhs) { return lhs->ID < rhs->ID; });
+
+    for (auto link : candidates)
         if (link->TestHit(to_imvec(p), c_LinkSelectThickness))
             return link;
 
@@ -1681,6 +2344,324 @@ void ed::EditorContext::UpdateAnimations()
     }
 }
 
+template <typename T, typename F>
+static void ReclaimObjects(std::vector<ed::ObjectWrapper<T>>& objects, F&& reclaim)
+{
+    objects.erase(std::remove_if(objects.begin(), objects.end(), [&reclaim](ed::ObjectWrapper<T>& object)
+    {
+        return reclaim(object.Object);
+    }), objects.end());
+}
+
+void ed::EditorContext::ReclaimDeadObjects()
+{
+    // Link can be live only when both of its pins are live, and pin only
+    // when its node is. So link never stays alive longer than its pins
+    // and pins longer than the node, every object can be tested alone.
+    const auto frameIndex = FrameIndex;
+    const auto threshold  = Config.ReclaimAfterFrames;
+    auto isDead = [frameIndex, threshold](const Object* object)
+    {
+        return !object->IsLive() && frameIndex - std::max(object->LiveFrame, object->CreationFrame) > threshold;
+    };
+
+    auto forget = [&isDead](vector<Object*>& objects)
+    {
+        objects.erase(std::remove_if(objects.begin(), objects.end(), isDead), objects.end());
+    };
+
+    // Drop references to dead objects before releasing them
+    forget(SelectedObjects);
+    forget(LastSelectedObjects);
+
+    if (LastActiveLink && isDead(LastActiveLink))
+        LastActiveLink = nullptr;
+    if (LastActiveObject && isDead(LastActiveObject))
+        LastActiveObject = nullptr;
+    if ((PickedObject && isDead(PickedObject)) || (PickedLink && isDead(PickedLink)))
+    {
+        PickedObject = nullptr;
+        PickedLink   = nullptr;
+        NotifySceneChanged();
+    }
+
+    ReclaimObjects(Links, [this, &isDead](Link* link)
+    {
+        if (!isDead(link))
+            return false;
+
+        FlowAnimationController.Forget(link);
+        NavigateAction.Forget(link);
+        link->AttachPins(nullptr, nullptr);
+        LinkGrid.Remove(link);
+        LinkVisibility.Remove(link->VisibilitySlot);
+        ObjectIndex.Remove(link->ID);
+        LinkPool.Destroy(link);
+        return true;
+    });
+
+    ReclaimObjects(Pins, [this, &isDead](Pin* pin)
+    {
+        if (!isDead(pin))
+            return false;
+
+        NavigateAction.Forget(pin);
+        ObjectIndex.Remove(pin->ID);
+        PinPool.Destroy(pin);
+        return true;
+    });
+
+    vector<ObjectId> deadNodeIds;
+    ReclaimObjects(Nodes, [this, &isDead, &deadNodeIds](Node* node)
+    {
+        if (!isDead(node))
+        {
+            // Pin list of dead node may point to released pins
+            if (!node->IsLive())
+                node->LastPin = nullptr;
+            return false;
+        }
+
+        deadNodeIds.push_back(node->ID);
+
+        // Detach from group hierarchy, orphans will look for a new group
+        SetGroupParent(node, nullptr);
+        for (auto child : node->GroupChildren)
+        {
+            child->GroupParent = nullptr;
+            MarkGroupParentDirty(child);
+        }
+        if (node->IsGroupParentDirty)
+            DirtyGroupParents.erase(std::find(DirtyGroupParents.begin(), DirtyGroupParents.end(), node));
+        if (node->IsGroupContentDirty)
+            DirtyGroupContents.erase(std::find(DirtyGroupContents.begin(), DirtyGroupContents.end(), node));
+
+        UnlinkNodeZOrder(node);
+        if (node->IsZOrderDirty)
+            DirtyZOrder.erase(std::find(DirtyZOrder.begin(), DirtyZOrder.end(), node));
+
+        NavigateAction.Forget(node);
+        NodeGrid.Remove(node);
+        NodeVisibility.Remove(node->VisibilitySlot);
+        ObjectIndex.Remove(node->ID);
+        NodePool.Destroy(node);
+        return true;
+    });
+
+    SortedPinCount  = Pins.size();
+    SortedLinkCount = Links.size();
+
+    // Settings of released nodes are stale, node will start from
+    // scratch if it ever comes back.
+    if (!deadNodeIds.empty())
+    {
+        std::sort(deadNodeIds.begin(), deadNodeIds.end());
+
+        auto& nodeSettings = Settings.Nodes;
+        nodeSettings.erase(std::remove_if(nodeSettings.begin(), nodeSettings.end(), [&deadNodeIds](const NodeSettings& settings)
+        {
+            return std::binary_search(deadNodeIds.begin(), deadNodeIds.end(), settings.ID);
+        }), nodeSettings.end());
+
+        Settings.RebuildNodeIndex();
+    }
+}
+
+void ed::EditorContext::RaiseNode(Node* node)
+{
+    // Groups are ordered by area only
+    if (node->GroupArea >= 0 || node == ZOrderFront)
+        return;
+
+    UnlinkNodeZOrder(node);
+    LinkNodeZOrder(node);
+}
+
+void ed::EditorContext::LinkNodeZOrder(Node* node)
+{
+    if (node->Type == NodeType::Group)
+    {
+        // Largest group goes first, after groups of the same size
+        const auto area = node->GroupBounds.w * node->GroupBounds.h;
+        auto it = std::find_if(ZOrderGroups.begin(), ZOrderGroups.end(), [area](Node* group) { return group->GroupArea < area; });
+
+        node->GroupArea = area;
+        ZOrderGroups.insert(it, node);
+
+        // Groups are numbered below zero
+        const auto groupCount = static_cast<int>(ZOrderGroups.size());
+        for (auto i = 0; i < groupCount; ++i)
+            ZOrderGroups[i]->ZOrder = i - groupCount;
+    }
+    else
+    {
+        node->ZOrder       = NextZOrder++;
+        node->PrevInZOrder = ZOrderFront;
+        node->NextInZOrder = nullptr;
+
+        if (ZOrderFront)
+            ZOrderFront->NextInZOrder = node;
+        else
+            ZOrderBack = node;
+        ZOrderFront = node;
+    }
+
+    NotifySceneChanged();
+}
+
+void ed::EditorContext::UnlinkNodeZOrder(Node* node)
+{
+    if (node->GroupArea >= 0)
+    {
+        ZOrderGroups.erase(std::find(ZOrderGroups.begin(), ZOrderGroups.end(), node));
+        node->GroupArea = -1;
+
+        const auto groupCount = static_cast<int>(ZOrderGroups.size());
+        for (auto i = 0; i < groupCount; ++i)
+            ZOrderGroups[i]->ZOrder = i - groupCount;
+    }
+    else
+    {
+        if (node->PrevInZOrder)
+            node->PrevInZOrder->NextInZOrder = node->NextInZOrder;
+        else
+            ZOrderBack = node->NextInZOrder;
+
+        if (node->NextInZOrder)
+            node->NextInZOrder->PrevInZOrder = node->PrevInZOrder;
+        else
+            ZOrderFront = node->PrevInZOrder;
+
+        node->PrevInZOrder = nullptr;
+        node->NextInZOrder = nullptr;
+    }
+}
+
+void ed::EditorContext::UpdateGroupZOrder()
+{
+    // Group being resized keeps its place until resizing is done
+    auto endIt = std::remove_if(DirtyZOrder.begin(), DirtyZOrder.end(), [this](Node* node)
+    {
+        if (node == SizeAction.SizedNode)
+            return false;
+
+        UnlinkNodeZOrder(node);
+        LinkNodeZOrder(node);
+        node->IsZOrderDirty = false;
+        return true;
+    });
+
+    DirtyZOrder.erase(endIt, DirtyZOrder.end());
+}
+
+void ed::EditorContext::SetNodeDrawLayer(ImDrawList* drawList, Node* node, int layer)
+{
+    drawList->ChannelsSetCurrent(c_NodeStartChannel + layer);
+
+    // Continue segment if node is still drawing into the same layer
+    if (!NodeDrawSegments.empty() && NodeDrawSegments.back().Node == node && NodeDrawSegments.back().Layer == layer)
+        return;
+
+    NodeDrawSegments.push_back(NodeDrawSegment(node, layer, drawList->IdxBuffer.Size));
+}
+
+void ed::EditorContext::MergeNodeDrawLayers(ImDrawList* drawList)
+{
+    // Channels are accessed directly, make sure none of them is swapped out
+    auto lastCurrentChannel = drawList->_ChannelsCurrent;
+    drawList->ChannelsSetCurrent(0);
+
+    // Resolve ranges of segments. Segment ends where next one in the same
+    // layer begins, last one takes everything up to the end of channel.
+    NodeDrawSegment* lastSegment[c_NodeChannelCount] = {};
+    int              cmdIndex[c_NodeChannelCount]    = {};
+    int              cmdIdxStart[c_NodeChannelCount] = {};
+    for (auto& segment : NodeDrawSegments)
+    {
+        const auto& cmdBuffer = drawList->_Channels[c_NodeStartChannel + segment.Layer].CmdBuffer;
+
+        auto& index = cmdIndex[segment.Layer];
+        auto& start = cmdIdxStart[segment.Layer];
+        while (index < cmdBuffer.Size && start < segment.IdxBegin && start + static_cast<int>(cmdBuffer[index].ElemCount) <= segment.IdxBegin)
+            start += cmdBuffer[index++].ElemCount;
+
+        segment.CmdBegin    = index;
+        segment.CmdIdxStart = start;
+
+        if (lastSegment[segment.Layer])
+            lastSegment[segment.Layer]->IdxEnd = segment.IdxBegin;
+        lastSegment[segment.Layer] = &segment;
+    }
+    for (auto segment : lastSegment)
+        if (segment)
+            segment->IdxEnd = INT_MAX;
+
+    // Number live nodes in drawing order, groups go first
+    int drawOrder = 0;
+    for (auto node : ZOrderGroups)
+        node->DrawOrder = node->IsLive() ? drawOrder++ : -1;
+    const auto groupCount = drawOrder;
+    for (auto node = ZOrderBack; node; node = node->NextInZOrder)
+        node->DrawOrder = node->IsLive() ? drawOrder++ : -1;
+
+    // Bucket segments by (node, layer), recording order is kept in buckets
+    auto& buckets = DrawSegmentBuckets;
+    buckets.assign(drawOrder * c_NodeChannelCount + 1, 0);
+    for (auto& segment : NodeDrawSegments)
+        if (segment.Node->IsLive() && segment.Node->DrawOrder >= 0)
+            ++buckets[segment.Node->DrawOrder * c_NodeChannelCount + segment.Layer + 1];
+    for (size_t i = 1; i < buckets.size(); ++i)
+        buckets[i] += buckets[i - 1];
+
+    // Links are drawn between groups and regular nodes
+    const auto linkPosition = buckets[groupCount * c_NodeChannelCount];
+
+    SortedDrawSegments.resize(buckets.back());
+    for (auto& segment : NodeDrawSegments)
+        if (segment.Node->IsLive() && segment.Node->DrawOrder >= 0)
+            SortedDrawSegments[buckets[segment.Node->DrawOrder * c_NodeChannelCount + segment.Layer]++] = &segment;
+
+    // Copy everything into single channel
+    const auto targetChannel = drawList->_ChannelsCount;
+    ImDrawList_ChannelsGrow(drawList, targetChannel + 1);
+
+    auto& target = drawList->_Channels[targetChannel];
+    target.CmdBuffer.resize(0);
+
+    const auto segmentCount = static_cast<int>(SortedDrawSegments.size());
+    for (int i = 0; i <= segmentCount; ++i)
+    {
+        if (i == linkPosition)
+            for (int j = 0; j < c_LinkChannelCount; ++j)
+                ImDrawList_AppendChannelRange(target, drawList->_Channels[c_LinkStartChannel + j], 0, 0, 0, INT_MAX);
+
+        if (i == segmentCount)
+            break;
+
+        const auto& segment = *SortedDrawSegments[i];
+        ImDrawList_AppendChannelRange(target, drawList->_Channels[c_NodeStartChannel + segment.Layer],
+            segment.CmdBegin, segment.CmdIdxStart, segment.IdxBegin, segment.IdxEnd);
+    }
+
+    // Leave merged channels empty, but ready to be drawn into
+    for (int i = c_LinkStartChannel; i < c_NodeStartChannel + c_NodeChannelCount; ++i)
+    {
+        auto& channel = drawList->_Channels[i];
+
+        ImDrawCmd drawCmd;
+        drawCmd.ClipRect  = drawList->GetCurrentClipRect();
+        drawCmd.TextureId = drawList->_TextureIdStack.back();
+
+        channel.CmdBuffer.resize(0);
+        channel.IdxBuffer.resize(0);
+        channel.CmdBuffer.push_back(drawCmd);
+    }
+
+    NodeDrawSegments.clear();
+
+    drawList->ChannelsSetCurrent(lastCurrentChannel);
+}
+
 void ed::EditorContext::Flow(Link* link)
 {
     FlowAnimationController.Flow(link);
@@ -1742,10 +2723,10 @@ ed::Control ed::EditorContext::BuildControl(bool allowOffscreen)
     Object* doubleClickedObject = nullptr;
 
     // Emits invisible button and returns true if it is clicked.
-    auto emitInteractiveArea = [this](int id, const rect& rect)
+    auto emitInteractiveArea = [this](ObjectId id, const rect& rect)
     {
-        char idString[33]; // itoa can output 33 bytes maximum
-        _itoa(id, idString, 16);
+        char idString[65]; // _ui64toa can output 65 bytes maximum
+        _ui64toa(static_cast<unsigned long long>(id), idString, 16);
         ImGui::SetCursorScreenPos(to_imvec(rect.location));
 
         // debug
@@ -1761,58 +2742,47 @@ ed::Control ed::EditorContext::BuildControl(bool allowOffscreen)
     };
 
     // Check input interactions over area.
-    auto checkInteractionsInArea = [&emitInteractiveArea, &hotObject, &activeObject, &clickedObject, &doubleClickedObject](int id, const rect& rect, Object* object)
+    auto checkInteractionsInArea = [&emitInteractiveArea, &activeObject, &clickedObject, &doubleClickedObject](ObjectId id, const rect& rect, Object* object)
     {
         if (emitInteractiveArea(id, rect))
             clickedObject = object;
         if (!doubleClickedObject && ImGui::IsMouseDoubleClicked(0) && ImGui::IsItemHoveredRect())
             doubleClickedObject = object;
 
-        if (!hotObject && ImGui::IsItemHoveredRect())
-            hotObject = object;
-
         if (ImGui::IsItemActive())
             activeObject = object;
     };
 
-    // Process live nodes and pins.
-    for (auto nodeIt = Nodes.rbegin(), nodeItEnd = Nodes.rend(); nodeIt != nodeItEnd; ++nodeIt)
-    {
-        auto node = *nodeIt;
-
-        if (!node->IsLive) continue;
-
-        // Check for interactions with live pins in node before
-        // processing node itself. Pins does not overlap each other
-        // and all are within node bounds.
-        for (auto pin = node->LastPin; pin; pin = pin->PreviousPin)
-        {
-            if (!pin->IsLive) continue;
-
-            checkInteractionsInArea(pin->ID, pin->Bounds, pin);
-        }
+    // Only object under cursor and object holding ImGui active state from
+    // previous frame need an item. Everything else cannot be hovered nor
+    // pressed in this frame. Object under cursor goes first, as top-most
+    // item did when every object had one.
+    //
+    // Picking result depends only on mouse position and scene, when neither
+    // changed since last frame result from that frame is still valid.
+    // Mouse is in canvas space, so panning and zooming move it too.
+    if (LiveObjectCount != LastLiveObjectCount)
+        NotifySceneChanged();
+
+    const auto canReusePick = PickSceneVersion == SceneVersion &&
+        PickMousePos.x == ImGui::GetMousePos().x && PickMousePos.y == ImGui::GetMousePos().y;
+    if (!canReusePick)
+    {
+        PickSceneVersion = SceneVersion;
+        PickMousePos     = ImGui::GetMousePos();
+        PickedObject     = PickObjectAt(PickMousePos);
+        PickedLink       = PickedObject ? nullptr : FindLinkAt(mousePos);
+    }
 
-        // Check for interactions with node.
-        if (node->Type == NodeType::Group)
-        {
-            // Node with a hole
-            ImGui::PushID(node->ID);
+    hotObject = PickedObject;
 
-            const auto top    = node->GroupBounds.top()  - node->Bounds.top();
-            const auto left   = node->GroupBounds.left() - node->Bounds.left();
-            const auto bottom = node->Bounds.bottom()    - node->GroupBounds.bottom();
-            const auto right  = node->Bounds.right()     - node->GroupBounds.right();
+    if (hotObject)
+        checkInteractionsInArea(hotObject->ID, GetInteractiveArea(hotObject, ImGui::GetMousePos()), hotObject);
 
-            checkInteractionsInArea(1, rect(node->Bounds.left(),  node->Bounds.top(),             node->Bounds.w, top),    node);
-            checkInteractionsInArea(2, rect(node->Bounds.left(),  node->Bounds.bottom() - bottom, node->Bounds.w, bottom), node);
-            checkInteractionsInArea(3, rect(node->Bounds.left(),  node->Bounds.top() + top,       left, node->Bounds.h - top - bottom), node);
-            checkInteractionsInArea(4, rect(node->Bounds.right() - right, node->Bounds.top() + top, right, node->Bounds.h - top - bottom), node);
+    if (LastActiveObject && LastActiveObject != hotObject && LastActiveObject->IsLive())
+        checkInteractionsInArea(LastActiveObject->ID, GetInteractiveArea(LastActiveObject, ImGui::GetMousePos()), LastActiveObject);
 
-            ImGui::PopID();
-        }
-        else
-            checkInteractionsInArea(node->ID, node->Bounds, node);
-    }
+    LastActiveObject = activeObject;
 
     // Links are not regular widgets and must be done manually since
     // ImGui does not support interactive elements with custom hit maps.
@@ -1822,7 +2792,7 @@ ed::Control ed::EditorContext::BuildControl(bool allowOffscreen)
     // Links are just over background. So if anything else
     // is hovered we can skip them.
     if (nullptr == hotObject)
-        hotObject = FindLinkAt(mousePos);
+        hotObject = PickedLink;
 
     // Check for interaction with background.
     auto backgroundClicked       = emitInteractiveArea(0, editorRect);
@@ -1904,9 +2874,9 @@ void ed::EditorContext::ShowMetrics(const Control& control)
             return "<???>";
     };
 
-    auto liveNodeCount  = (int)std::count_if(Nodes.begin(),  Nodes.end(),  [](Node*  node)  { return  node->IsLive; });
-    auto livePinCount   = (int)std::count_if(Pins.begin(),   Pins.end(),   [](Pin*   pin)   { return   pin->IsLive; });
-    auto liveLinkCount  = (int)std::count_if(Links.begin(),  Links.end(),  [](Link*  link)  { return  link->IsLive; });
+    auto liveNodeCount  = NodeVisibility.CountLive(FrameIndex);
+    auto livePinCount   = (int)std::count_if(Pins.begin(),   Pins.end(),   [](Pin*   pin)   { return   pin->IsLive(); });
+    auto liveLinkCount  = LinkVisibility.CountLive(FrameIndex);
 
     ImGui::SetCursorPos(ImVec2(10, 10));
     ImGui::BeginGroup();
@@ -1918,13 +2888,13 @@ void ed::EditorContext::ShowMetrics(const Control& control)
     ImGui::Text("Live Nodes: %d", liveNodeCount);
     ImGui::Text("Live Pins: %d", livePinCount);
     ImGui::Text("Live Links: %d", liveLinkCount);
-    ImGui::Text("Hot Object: %s (%d)", getHotObjectName(), control.HotObject ? control.HotObject->ID : 0);
+    ImGui::Text("Hot Object: %s (%llu)", getHotObjectName(), static_cast<unsigned long long>(control.HotObject ? control.HotObject->ID : 0));
     if (auto node = control.HotObject ? control.HotObject->AsNode() : nullptr)
     {
         ImGui::SameLine();
         ImGui::Text("{ x=%d y=%d w=%d h=%d }", node->Bounds.x, node->Bounds.y, node->Bounds.w, node->Bounds.h);
     }
-    ImGui::Text("Active Object: %s (%d)", getActiveObjectName(), control.ActiveObject ? control.ActiveObject->ID : 0);
+    ImGui::Text("Active Object: %s (%llu)", getActiveObjectName(), static_cast<unsigned long long>(control.ActiveObject ? control.ActiveObject->ID : 0));
     if (auto node = control.ActiveObject ? control.ActiveObject->AsNode() : nullptr)
     {
         ImGui::SameLine();
@@ -2056,19 +3026,30 @@ bool ed::NodeSettings::Parse(const json::value& data, NodeSettings& result)
 // Settings
 //
 //------------------------------------------------------------------------------
-ed::NodeSettings* ed::Settings::AddNode(int id)
+ed::NodeSettings* ed::Settings::AddNode(ObjectId id)
 {
+    assert(nullptr == FindNode(id));
+
     Nodes.push_back(NodeSettings(id));
+    NodeIndex.Insert(id, static_cast<int>(Nodes.size() - 1));
+
     return &Nodes.back();
 }
 
-ed::NodeSettings* ed::Settings::FindNode(int id)
+ed::NodeSettings* ed::Settings::FindNode(ObjectId id)
 {
-    for (auto& settings : Nodes)
-        if (settings.ID == id)
-            return &settings;
+    auto position = NodeIndex.Find(id);
+    return position ? &Nodes[*position] : nullptr;
+}
 
-    return nullptr;
+void ed::Settings::RebuildNodeIndex()
+{
+    NodeIndex.Clear();
+
+    // First entry wins if the same ID was stored twice
+    for (int position = 0, count = static_cast<int>(Nodes.size()); position < count; ++position)
+        if (!NodeIndex.Find(Nodes[position].ID))
+            NodeIndex.Insert(Nodes[position].ID, position);
 }
 
 void ed::Settings::ClearDirty(Node* node)
@@ -2122,7 +3103,7 @@ std::string ed::Settings::Serialize()
 
     json::array selection;
     for (auto& id : Selection)
-        selection.push_back(json::value(static_cast<double>(id)));
+        selection.push_back(json::value(std::to_string(id)));
 
     json::object view;
     view["scroll"] = json::value(serializeVector(ViewScroll));
@@ -2174,18 +3155,18 @@ bool ed::Settings::Parse(const char* data, const char* dataEnd, Settings& settin
     auto& nodesValue = settingsValue.get("nodes");
     if (nodesValue.is<json::object>())
     {
+        result.Nodes.reserve(nodesValue.get<json::object>().size());
         for (auto& node : nodesValue.get<json::object>())
         {
-            auto id = static_cast<int>(strtoll(node.first.c_str(), nullptr, 10));
+            auto id = static_cast<ObjectId>(strtoull(node.first.c_str(), nullptr, 10));
 
-            auto settings = result.FindNode(id);
-            if (!settings)
-                settings = result.AddNode(id);
-
-            NodeSettings::Parse(node.second, *settings);
+            result.Nodes.push_back(NodeSettings(id));
+            NodeSettings::Parse(node.second, result.Nodes.back());
         }
     }
 
+    result.RebuildNodeIndex();
+
     auto& selectionValue = settingsValue.get("selection");
     if (selectionValue.is<json::array>())
     {
@@ -2195,8 +3176,12 @@ bool ed::Settings::Parse(const char* data, const char* dataEnd, Settings& settin
         result.Selection.resize(0);
         for (auto& selection : selectionArray)
         {
-            if (selection.is<double>())
-                result.Selection.push_back(static_cast<int>(selection.get<double>()));
+            // IDs are stored as strings, doubles cannot represent all 64-bit values.
+            // Doubles are still accepted to read settings saved by older versions.
+            if (selection.is<std::string>())
+                result.Selection.push_back(static_cast<ObjectId>(strtoull(selection.get<std::string>().c_str(), nullptr, 10)));
+            else if (selection.is<double>())
+                result.Selection.push_back(static_cast<ObjectId>(selection.get<double>()));
         }
     }
 
@@ -2464,7 +3449,7 @@ void ed::FlowAnimation::Draw(ImDrawList* drawList)
 
     const auto flowAlpha = 1.0f - progress * progress;
     const auto flowColor = Editor->GetColor(StyleColor_Flow, flowAlpha);
-    const auto flowPath  = Link->GetCurve();
+    const auto& flowPath  = Link->GetCurve();
 
     Link->Draw(drawList, flowColor, 2.0f);
 
@@ -2483,7 +3468,7 @@ void ed::FlowAnimation::Draw(ImDrawList* drawList)
 
 bool ed::FlowAnimation::IsLinkValid() const
 {
-    return Link && Link->IsLive;
+    return Link && Link->IsLive();
 }
 
 bool ed::FlowAnimation::IsPathValid() const
@@ -2499,7 +3484,7 @@ void ed::FlowAnimation::UpdatePath()
         return;
     }
 
-    const auto curve  = Link->GetCurve();
+    const auto& curve  = Link->GetCurve();
 
     LastStart  = Link->Start;
     LastEnd    = Link->End;
@@ -2570,7 +3555,7 @@ ed::FlowAnimationController::~FlowAnimationController()
 
 void ed::FlowAnimationController::Flow(Link* link)
 {
-    if (!link || !link->IsLive)
+    if (!link || !link->IsLive())
         return;
 
     auto& editorStyle = GetStyle();
@@ -2619,6 +3604,18 @@ void ed::FlowAnimationController::Release(FlowAnimation* animation)
 {
 }
 
+void ed::FlowAnimationController::Forget(Link* link)
+{
+    for (auto animation : Animations)
+    {
+        if (animation->Link != link)
+            continue;
+
+        animation->Stop();
+        animation->Link = nullptr;
+    }
+}
+
 
 
 //------------------------------------------------------------------------------
@@ -2907,6 +3904,12 @@ void ed::NavigateAction::SetWindow(ImVec2 position, ImVec2 size)
     WindowScreenSize = size;
 }
 
+void ed::NavigateAction::Forget(Object* object)
+{
+    if (LastObject == object)
+        LastObject = nullptr;
+}
+
 ed::Canvas ed::NavigateAction::GetCanvas(bool alignToPixels)
 {
     ImVec2 origin = -Scroll;
@@ -3117,6 +4120,8 @@ bool ed::SizeAction::Process(const Control& control)
             StartBounds.top()         - StartGroupBounds.top(),
             StartGroupBounds.right()  - StartBounds.right(),
             StartGroupBounds.bottom() - StartBounds.bottom());
+
+        Editor->NotifyNodeBoundsChanged(SizedNode);
     }
     else if (!control.ActiveNode)
     {
@@ -3143,7 +4148,7 @@ void ed::SizeAction::ShowMetrics()
 
     ImGui::Text("%s:", GetName());
     ImGui::Text("    Active: %s", IsActive ? "yes" : "no");
-    ImGui::Text("    Node: %s (%d)", getObjectName(SizedNode), SizedNode ? SizedNode->ID : 0);
+    ImGui::Text("    Node: %s (%llu)", getObjectName(SizedNode), static_cast<unsigned long long>(SizedNode ? SizedNode->ID : 0));
     if (SizedNode && IsActive)
     {
         ImGui::Text("    Bounds: { x=%d y=%d w=%d h=%d }", SizedNode->Bounds.x, SizedNode->Bounds.y, SizedNode->Bounds.w, SizedNode->Bounds.h);
@@ -3356,7 +4361,7 @@ void ed::DragAction::ShowMetrics()
 
     ImGui::Text("%s:", GetName());
     ImGui::Text("    Active: %s", IsActive ? "yes" : "no");
-    ImGui::Text("    Node: %s (%d)", getObjectName(DraggedObject), DraggedObject ? DraggedObject->ID : 0);
+    ImGui::Text("    Node: %s (%llu)", getObjectName(DraggedObject), static_cast<unsigned long long>(DraggedObject ? DraggedObject->ID : 0));
 }
 
 
@@ -3374,7 +4379,10 @@ ed::SelectAction::SelectAction(EditorContext* editor):
     SelectLinkMode(false),
     CommitSelection(false),
     StartPoint(),
-    Animation(editor)
+    Animation(editor),
+    CandidateIndex(),
+    CandidateRect(),
+    CandidateSceneVersion(0)
 {
 }
 
@@ -3405,7 +4413,13 @@ ed::EditorAction::AcceptResult ed::SelectAction::Accept(const Control& control)
         }
 
         if (io.KeyCtrl)
+        {
             SelectedObjectsAtStart = Editor->GetSelectedObjects();
+            std::sort(SelectedObjectsAtStart.begin(), SelectedObjectsAtStart.end());
+        }
+
+        // Force full search in first update
+        CandidateRect = ax::rectf();
     }
     else if (control.BackgroundClicked)
     {
@@ -3446,6 +4460,7 @@ bool ed::SelectAction::Process(const Control& control)
             Editor->SelectObject(object);
 
         CandidateObjects.clear();
+        CandidateIndex.clear();
 
         CommitSelection = false;
     }
@@ -3467,34 +4482,15 @@ bool ed::SelectAction::Process(const Control& control)
         if (rect.h <= 0)
             rect.h = 1;
 
-        vector<Node*> nodes;
-        vector<Link*> links;
-
-        if (SelectLinkMode)
-        {
-            Editor->FindLinksInRect(rect, links);
-            CandidateObjects.assign(links.begin(), links.end());
-        }
-        else
-        {
-            Editor->FindNodesInRect(rect, nodes);
-            CandidateObjects.assign(nodes.begin(), nodes.end());
-
-            if (SelectGroups)
-            {
-                auto endIt = std::remove_if(CandidateObjects.begin(), CandidateObjects.end(), [](Object* object) { return !IsGroup(object->AsNode()); });
-                CandidateObjects.erase(endIt, CandidateObjects.end());
-            }
-            else
-            {
-                auto endIt = std::remove_if(CandidateObjects.begin(), CandidateObjects.end(), [](Object* object) { return IsGroup(object->AsNode()); });
-                CandidateObjects.erase(endIt, CandidateObjects.end());
-            }
-        }
+        // Candidates change only where rectangle moved, unless scene changed
+        // under it
+        if (CandidateRect.is_empty() || CandidateSceneVersion != Editor->GetSceneVersion())
+            RebuildCandidates(rect);
+        else if (rect.x != CandidateRect.x || rect.y != CandidateRect.y || rect.w != CandidateRect.w || rect.h != CandidateRect.h)
+            UpdateCandidates(rect);
 
-        CandidateObjects.insert(CandidateObjects.end(), SelectedObjectsAtStart.begin(), SelectedObjectsAtStart.end());
-        std::sort(CandidateObjects.begin(), CandidateObjects.end());
-        CandidateObjects.erase(std::unique(CandidateObjects.begin(), CandidateObjects.end()), CandidateObjects.end());
+        CandidateRect         = rect;
+        CandidateSceneVersion = Editor->GetSceneVersion();
     }
     else
     {
@@ -3510,6 +4506,118 @@ bool ed::SelectAction::Process(const Control& control)
     return IsActive;
 }
 
+bool ed::SelectAction::AcceptsCandidate(Object* object, const ax::rectf& rect) const
+{
+    if (std::binary_search(SelectedObjectsAtStart.begin(), SelectedObjectsAtStart.end(), object))
+        return true;
+
+    if (SelectLinkMode)
+        return object->IsLink() && object->TestHit(rect);
+    else
+        return object->IsNode() && IsGroup(object->AsNode()) == SelectGroups && object->TestHit(rect);
+}
+
+void ed::SelectAction::SetCandidate(Object* object, bool isCandidate)
+{
+    auto it = CandidateIndex.find(object);
+    if (isCandidate)
+    {
+        if (it == CandidateIndex.end())
+        {
+            CandidateIndex[object] = CandidateObjects.size();
+            CandidateObjects.push_back(object);
+        }
+    }
+    else if (it != CandidateIndex.end())
+    {
+        // Swap with last, order of candidates is not important
+        const auto index = it->second;
+        CandidateIndex.erase(it);
+
+        if (index != CandidateObjects.size() - 1)
+        {
+            CandidateObjects[index] = CandidateObjects.back();
+            CandidateIndex[CandidateObjects[index]] = index;
+        }
+
+        CandidateObjects.pop_back();
+    }
+}
+
+void ed::SelectAction::RebuildCandidates(const ax::rectf& rect)
+{
+    CandidateObjects.clear();
+    CandidateIndex.clear();
+
+    for (auto object : SelectedObjectsAtStart)
+        SetCandidate(object, true);
+
+    if (SelectLinkMode)
+    {
+        vector<Link*> links;
+        Editor->FindLinksInRect(rect, links);
+        for (auto link : links)
+            SetCandidate(link, true);
+    }
+    else
+    {
+        vector<Node*> nodes;
+        Editor->FindNodesInRect(rect, nodes);
+        for (auto node : nodes)
+            if (IsGroup(node) == SelectGroups)
+                SetCandidate(node, true);
+    }
+}
+
+void ed::SelectAction::UpdateCandidates(const ax::rectf& rect)
+{
+    // Only objects touching area covered by one rectangle but not
+    // the other can change state. Area is split into strips.
+    vector<ax::rectf> strips;
+    auto subtract = [&strips](const ax::rectf& a, const ax::rectf& b)
+    {
+        const auto common = make_intersection(a, b);
+        if (common.is_empty())
+        {
+            strips.push_back(a);
+            return;
+        }
+
+        if (common.top() > a.top())
+            strips.push_back(ax::rectf(a.left(), a.top(), a.w, common.top() - a.top()));
+        if (common.bottom() < a.bottom())
+            strips.push_back(ax::rectf(a.left(), common.bottom(), a.w, a.bottom() - common.bottom()));
+        if (common.left() > a.left())
+            strips.push_back(ax::rectf(a.left(), common.top(), common.left() - a.left(), common.h));
+        if (common.right() < a.right())
+            strips.push_back(ax::rectf(common.right(), common.top(), a.right() - common.right(), common.h));
+    };
+
+    subtract(CandidateRect, rect);
+    subtract(rect, CandidateRect);
+
+    vector<Node*> nodes;
+    vector<Link*> links;
+    for (auto strip : strips)
+    {
+        // Catch objects touching strip edges
+        strip.expand(1.0f);
+
+        if (SelectLinkMode)
+        {
+            Editor->FindLinksInRect(strip, links);
+            for (auto link : links)
+                SetCandidate(link, AcceptsCandidate(link, rect));
+        }
+        else
+        {
+            Editor->FindNodesInRect(strip, nodes);
+            for (auto node : nodes)
+                SetCandidate(node, AcceptsCandidate(node, rect));
+        }
+    }
+}
+
 void ed::SelectAction::ShowMetrics()
 {
     EditorAction::ShowMetrics();
@@ -3563,8 +4671,8 @@ ed::EditorAction::AcceptResult ed::ContextMenuAction::Accept(const Control& cont
 
     if (isPressed || isReleased || isDragging)
     {
-        Menu candidateMenu = ContextMenuAction::None;
-        int  contextId     = 0;
+        Menu     candidateMenu = ContextMenuAction::None;
+        ObjectId contextId     = 0;
 
         if (auto hotObejct = control.HotObject)
         {
@@ -3642,7 +4750,7 @@ void ed::ContextMenuAction::ShowMetrics()
     ImGui::Text("    Menu: %s", getMenuName(CurrentMenu));
 }
 
-bool ed::ContextMenuAction::ShowNodeContextMenu(int* nodeId)
+bool ed::ContextMenuAction::ShowNodeContextMenu(ObjectId* nodeId)
 {
     if (CurrentMenu != Node)
         return false;
@@ -3652,7 +4760,7 @@ bool ed::ContextMenuAction::ShowNodeContextMenu(int* nodeId)
     return true;
 }
 
-bool ed::ContextMenuAction::ShowPinContextMenu(int* pinId)
+bool ed::ContextMenuAction::ShowPinContextMenu(ObjectId* pinId)
 {
     if (CurrentMenu != Pin)
         return false;
@@ -3662,7 +4770,7 @@ bool ed::ContextMenuAction::ShowPinContextMenu(int* pinId)
     return true;
 }
 
-bool ed::ContextMenuAction::ShowLinkContextMenu(int* linkId)
+bool ed::ContextMenuAction::ShowLinkContextMenu(ObjectId* linkId)
 {
     if (CurrentMenu != Link)
         return false;
@@ -3754,12 +4862,12 @@ ed::EditorAction::AcceptResult ed::ShortcutAction::Accept(const Control& control
                 return False;
 
             // Does copying only links make sense?
-            //const auto hasOnlyLinks = std::all_of(Context.begin(), Context.end(), [](Object* object) { return object->AsLink() != nullptr; });
+            //const auto hasOnlyLinks = std::all_of(Context.begin(), Context.end(), [](Object* object) { return object->IsLink(); });
             //if (hasOnlyLinks)
             //    return False;
 
             // If no links are selected, pick all links between nodes within context
-            const auto hasAnyLinks = std::any_of(Context.begin(), Context.end(), [](Object* object) { return object->AsLink() != nullptr; });
+            const auto hasAnyLinks = std::any_of(Context.begin(), Context.end(), [](Object* object) { return object->IsLink(); });
             if (!hasAnyLinks && Context.size() > 1) // one node cannot make connection to anything
             {
                 // Collect nodes in sorted vector viable for binary search
@@ -3770,7 +4878,7 @@ ed::EditorAction::AcceptResult ed::ShortcutAction::Accept(const Control& control
 
                 std::sort(nodes.begin(), nodes.end());
 
-                auto isNodeInContext = [&nodes](int nodeId)
+                auto isNodeInContext = [&nodes](ObjectId nodeId)
                 {
                     return std::binary_search(nodes.begin(), nodes.end(), ObjectWrapper<Node>{nodeId, nullptr});
                 };
@@ -3947,15 +5055,19 @@ bool ed::CreateItemAction::Process(const Control& control)
     {
         const auto draggingFromSource = (DraggedPin->Kind == PinKind::Source);
 
+        // Temporaries are not part of scene, they are stamped live without
+        // MarkLive(), which would change scene version and live object count
         ed::Pin cursorPin(Editor, 0, draggingFromSource ? PinKind::Target : PinKind::Source);
-        cursorPin.Pivot    = ax::rectf(to_pointf(ImGui::GetMousePos()), sizef(0, 0));
-        cursorPin.Dir      = -DraggedPin->Dir;
-        cursorPin.Strength =  DraggedPin->Strength;
+        cursorPin.LiveFrame = Editor->GetFrameIndex();
+        cursorPin.Pivot     = ax::rectf(to_pointf(ImGui::GetMousePos()), sizef(0, 0));
+        cursorPin.Dir       = -DraggedPin->Dir;
+        cursorPin.Strength  =  DraggedPin->Strength;
 
         ed::Link candidate(Editor, 0);
-        candidate.Color    = LinkColor;
-        candidate.StartPin = draggingFromSource ? DraggedPin : &cursorPin;
-        candidate.EndPin   = draggingFromSource ? &cursorPin : DraggedPin;
+        candidate.LiveFrame = Editor->GetFrameIndex();
+        candidate.Color     = LinkColor;
+        candidate.StartPin  = draggingFromSource ? DraggedPin : &cursorPin;
+        candidate.EndPin    = draggingFromSource ? &cursorPin : DraggedPin;
 
         ed::Pin*& freePin  = draggingFromSource ? candidate.EndPin : candidate.StartPin;
 
@@ -3975,6 +5087,7 @@ bool ed::CreateItemAction::Process(const Control& control)
         drawList->ChannelsSetCurrent(c_LinkChannel_NewLink);
 
         candidate.UpdateEndpoints();
+        candidate.UpdateGeometry();
         candidate.Draw(drawList, LinkColor, LinkThickness);
     }
     else if (CurrentStage == Possible || !control.ActivePin)
@@ -4064,6 +5177,7 @@ void ed::CreateItemAction::End()
     if (IsInGlobalSpace)
     {
         ImGui::PopClipRect();
+        Editor->EnterCanvasSpace();
         IsInGlobalSpace = false;
     }
 
@@ -4153,15 +5267,15 @@ ed::CreateItemAction::Result ed::CreateItemAction::AcceptItem()
         return False;
 }
 
-ed::CreateItemAction::Result ed::CreateItemAction::QueryLink(int* startId, int* endId)
+ed::CreateItemAction::Result ed::CreateItemAction::QueryLink(ObjectId* startId, ObjectId* endId)
 {
     IM_ASSERT(InActive);
 
     if (!InActive || CurrentStage == None || ItemType != Link)
         return Indeterminate;
 
-    int linkStartId = LinkStart->ID;
-    int linkEndId   = LinkEnd->ID;
+    ObjectId linkStartId = LinkStart->ID;
+    ObjectId linkEndId   = LinkEnd->ID;
 
     *startId = linkStartId;
     *endId   = linkEndId;
@@ -4171,6 +5285,7 @@ ed::CreateItemAction::Result ed::CreateItemAction::QueryLink(int* startId, int*
     if (!IsInGlobalSpace)
     {
         auto& canvas = Editor->GetCanvas();
+        Editor->LeaveCanvasSpace();
         ImGui::PushClipRect(canvas.WindowScreenPos + ImVec2(1, 1), canvas.WindowScreenPos + canvas.WindowScreenSize - ImVec2(1, 1), false);
         IsInGlobalSpace = true;
     }
@@ -4178,7 +5293,7 @@ ed::CreateItemAction::Result ed::CreateItemAction::QueryLink(int* startId, int*
     return True;
 }
 
-ed::CreateItemAction::Result ed::CreateItemAction::QueryNode(int* pinId)
+ed::CreateItemAction::Result ed::CreateItemAction::QueryNode(ObjectId* pinId)
 {
     IM_ASSERT(InActive);
 
@@ -4192,6 +5307,7 @@ ed::CreateItemAction::Result ed::CreateItemAction::QueryNode(int* pinId)
     if (!IsInGlobalSpace)
     {
         auto& canvas = Editor->GetCanvas();
+        Editor->LeaveCanvasSpace();
         ImGui::PushClipRect(canvas.WindowScreenPos + ImVec2(1, 1), canvas.WindowScreenPos + canvas.WindowScreenSize - ImVec2(1, 1), false);
         IsInGlobalSpace = true;
     }
@@ -4339,7 +5455,7 @@ void ed::DeleteItemsAction::End()
     InInteraction = false;
 }
 
-bool ed::DeleteItemsAction::QueryLink(int* linkId, int* startId, int* endId)
+bool ed::DeleteItemsAction::QueryLink(ObjectId* linkId, ObjectId* startId, ObjectId* endId)
 {
     if (!QueryItem(linkId, Link))
         return false;
@@ -4356,12 +5472,12 @@ bool ed::DeleteItemsAction::QueryLink(int* linkId, int* startId, int* endId)
     return true;
 }
 
-bool ed::DeleteItemsAction::QueryNode(int* nodeId)
+bool ed::DeleteItemsAction::QueryNode(ObjectId* nodeId)
 {
     return QueryItem(nodeId, Node);
 }
 
-bool ed::DeleteItemsAction::QueryItem(int* itemId, IteratorType itemType)
+bool ed::DeleteItemsAction::QueryItem(ObjectId* itemId, IteratorType itemType)
 {
     if (!InInteraction)
         return false;
@@ -4382,21 +5498,10 @@ bool ed::DeleteItemsAction::QueryItem(int* itemId, IteratorType itemType)
     while (CandidateItemIndex < itemCount)
     {
         auto item = CandidateObjects[CandidateItemIndex];
-        if (itemType == Node)
-        {
-            if (auto node = item->AsNode())
-            {
-                *itemId = node->ID;
-                return true;
-            }
-        }
-        else if (itemType == Link)
+        if ((itemType == Node && item->IsNode()) || (itemType == Link && item->IsLink()))
         {
-            if (auto link = item->AsLink())
-            {
-                *itemId = link->ID;
-                return true;
-            }
+            *itemId = item->ID;
+            return true;
         }
 
         ++CandidateItemIndex;
@@ -4456,7 +5561,7 @@ ed::NodeBuilder::NodeBuilder(EditorContext* editor):
 {
 }
 
-void ed::NodeBuilder::Begin(int nodeId)
+void ed::NodeBuilder::Begin(ObjectId nodeId)
 {
     assert(nullptr == CurrentNode);
 
@@ -4485,6 +5590,7 @@ void ed::NodeBuilder::Begin(int nodeId)
                 {
                     node->Bounds.location += offset;
                     node->GroupBounds.location += offset;
+                    Editor->NotifyNodeBoundsChanged(node);
                     Editor->MakeDirty(SaveReasonFlags::Position | SaveReasonFlags::User, node);
                 }
             }
@@ -4506,7 +5612,8 @@ void ed::NodeBuilder::Begin(int nodeId)
 
     const auto alpha = ImGui::GetStyle().Alpha;
 
-    CurrentNode->IsLive           = true;
+    CurrentNode->MarkLive();
+
     CurrentNode->LastPin          = nullptr;
     CurrentNode->Color            = Editor->GetColor(StyleColor_NodeBg, alpha);
     CurrentNode->BorderColor      = Editor->GetColor(StyleColor_NodeBorder, alpha);
@@ -4519,13 +5626,9 @@ void ed::NodeBuilder::Begin(int nodeId)
 
     IsGroup = false;
 
-    // Grow channel list and select user channel
+    // Select user channel
     if (auto drawList = ImGui::GetWindowDrawList())
-    {
-        CurrentNode->Channel = drawList->_ChannelsCount;
-        ImDrawList_ChannelsGrow(drawList, drawList->_ChannelsCount + c_ChannelsPerNode);
-        drawList->ChannelsSetCurrent(CurrentNode->Channel + c_NodeContentChannel);
-    }
+        Editor->SetNodeDrawLayer(drawList, CurrentNode, c_NodeContentChannel);
 
     // Begin outer group
     ImGui::BeginGroup();
@@ -4577,10 +5680,17 @@ void ed::NodeBuilder::End()
     else
         CurrentNode->Type        = NodeType::Node;
 
+    // Location may have changed since last frame too, this catches every
+    // change made outside of actions
+    Editor->NotifyNodeBoundsChanged(CurrentNode);
+
+    if (IsGroup)
+        Editor->NotifyGroupSubmitted(CurrentNode);
+
     CurrentNode = nullptr;
 }
 
-void ed::NodeBuilder::BeginPin(int pinId, PinKind kind)
+void ed::NodeBuilder::BeginPin(ObjectId pinId, PinKind kind)
 {
     assert(nullptr != CurrentNode);
     assert(nullptr == CurrentPin);
@@ -4591,7 +5701,16 @@ void ed::NodeBuilder::BeginPin(int pinId, PinKind kind)
     CurrentPin = Editor->GetPin(pinId, kind);
     CurrentPin->Node = CurrentNode;
 
-    CurrentPin->IsLive      = true;
+    LastPivot     = CurrentPin->Pivot;
+    LastRadius    = CurrentPin->Radius;
+    LastArrowSize = CurrentPin->ArrowSize;
+    LastDir       = CurrentPin->Dir;
+    LastStrength  = CurrentPin->Strength;
+    LastBounds    = CurrentPin->Bounds;
+
+    CurrentPin->MarkLive();
+    CurrentPin->DetachDeadLinks();
+
     CurrentPin->Color       = Editor->GetColor(StyleColor_PinRect);
     CurrentPin->BorderColor = Editor->GetColor(StyleColor_PinRectBorder);
     CurrentPin->BorderWidth = editorStyle.PinBorderWidth;
@@ -4637,6 +5756,17 @@ void ed::NodeBuilder::EndPin()
         CurrentPin->Pivot.size     = static_cast<sizef>((to_pointf(PivotSize).cwise_product(to_pointf(PivotScale))));
     }
 
+    // Let links know endpoints and curves have to be recomputed
+    auto& pivot = CurrentPin->Pivot;
+    if (pivot.x != LastPivot.x || pivot.y != LastPivot.y || pivot.w != LastPivot.w || pivot.h != LastPivot.h ||
+        CurrentPin->Radius    != LastRadius    || CurrentPin->ArrowSize != LastArrowSize ||
+        CurrentPin->Dir       != LastDir       || CurrentPin->Strength  != LastStrength)
+        ++CurrentPin->Version;
+
+    auto& bounds = CurrentPin->Bounds;
+    if (bounds.x != LastBounds.x || bounds.y != LastBounds.y || bounds.w != LastBounds.w || bounds.h != LastBounds.h)
+        Editor->NotifySceneChanged();
+
     CurrentPin = nullptr;
 }
 
@@ -4703,10 +5833,10 @@ ImDrawList* ed::NodeBuilder::GetUserBackgroundDrawList() const
 
 ImDrawList* ed::NodeBuilder::GetUserBackgroundDrawList(Node* node) const
 {
-    if (node && node->IsLive)
+    if (node && node->IsLive())
     {
         auto drawList = ImGui::GetWindowDrawList();
-        drawList->ChannelsSetCurrent(node->Channel + c_NodeUserBackgroundChannel);
+        Editor->SetNodeDrawLayer(drawList, node, c_NodeUserBackgroundChannel);
         return drawList;
     }
     else
@@ -4728,7 +5858,7 @@ ed::HintBuilder::HintBuilder(EditorContext* editor):
 {
 }
 
-bool ed::HintBuilder::Begin(int nodeId)
+bool ed::HintBuilder::Begin(ObjectId nodeId)
 {
     assert(nullptr == CurrentNode);
 
@@ -5015,7 +6145,7 @@ std::string ed::Config::Load()
     return data;
 }
 
-std::string ed::Config::LoadNode(int nodeId)
+std::string ed::Config::LoadNode(ObjectId nodeId)
 {
     std::string data;
 
@@ -5056,7 +6186,7 @@ bool ed::Config::Save(const std::string& data, SaveReasonFlags flags)
     return false;
 }
 
-bool ed::Config::SaveNode(int nodeId, const std::string& data, SaveReasonFlags flags)
+bool ed::Config::SaveNode(ObjectId nodeId, const std::string& data, SaveReasonFlags flags)
 {
     if (SaveNodeSettings)
         return SaveNodeSettings(nodeId, data.c_str(), data.size(), flags, UserPointer);
@@ -18,6 +18,8 @@ namespace ax { using namespace ImGuiInterop; }
 # define PICOJSON_USE_LOCALE 0
 # include "Contrib/picojson/picojson.h"
 # include <vector>
+# include <unordered_map>
+# include <algorithm>
 
 
 //------------------------------------------------------------------------------
@@ -43,9 +45,10 @@ void Log(const char* fmt, ...);
 //------------------------------------------------------------------------------
 enum class ObjectType
 {
-    Node, Pin
+    Node, Pin, Link
 };
 
+using ax::NodeEditor::ObjectId;
 using ax::NodeEditor::PinKind;
 using ax::NodeEditor::StyleColor;
 using ax::NodeEditor::StyleVar;
@@ -60,8 +63,8 @@ struct Link;
 template <typename T>
 struct ObjectWrapper
 {
-    int  ID;
-    T*   Object;
+    ObjectId ID;
+    T*       Object;
 
           T* operator->()        { return Object; }
     const T* operator->() const  { return Object; }
@@ -75,6 +78,397 @@ struct ObjectWrapper
     }
 };
 
+struct Object;
+
+// Maps object ID to a value. Uses open addressing with linear probing,
+// so lookup does not depend on order of objects in draw lists.
+template <typename T>
+struct IdIndex
+{
+    IdIndex(): Count(0) {}
+
+    void Clear()
+    {
+        Entries.clear();
+        Count = 0;
+    }
+
+    void Insert(ObjectId id, const T& value)
+    {
+        // Keep load factor below 1/2
+        if (static_cast<size_t>(Count + 1) * 2 > Entries.size())
+            Rehash(Entries.empty() ? 64 : Entries.size() * 2);
+
+        const auto mask = Entries.size() - 1;
+        for (auto i = Hash(id) & mask; ; i = (i + 1) & mask)
+        {
+            auto& entry = Entries[i];
+            if (!entry.IsUsed)
+            {
+                entry.ID     = id;
+                entry.Value  = value;
+                entry.IsUsed = true;
+                ++Count;
+                return;
+            }
+
+            assert(entry.ID != id);
+        }
+    }
+
+    void Remove(ObjectId id)
+    {
+        auto entry = Lookup(id);
+        if (!entry)
+            return;
+
+        // Backward shift deletion, moves following entries of the probe
+        // sequence into the hole so lookups never need tombstones.
+        const auto mask = Entries.size() - 1;
+        auto hole = static_cast<size_t>(entry - Entries.data());
+        for (auto i = (hole + 1) & mask; Entries[i].IsUsed; i = (i + 1) & mask)
+        {
+            const auto home = Hash(Entries[i].ID) & mask;
+
+            // Entry may move only if hole lies between its home slot and current slot
+            const auto distanceToHole  = (hole - home) & mask;
+            const auto distanceToEntry = (i    - home) & mask;
+            if (distanceToHole < distanceToEntry)
+            {
+                Entries[hole] = Entries[i];
+                hole = i;
+            }
+        }
+
+        Entries[hole].IsUsed = false;
+        --Count;
+    }
+
+    const T* Find(ObjectId id) const
+    {
+        auto entry = Lookup(id);
+        return entry ? &entry->Value : nullptr;
+    }
+
+    int Size() const { return Count; }
+
+private:
+    struct Entry
+    {
+        ObjectId ID;
+        T        Value;
+        bool     IsUsed;
+    };
+
+    static size_t Hash(ObjectId id)
+    {
+        // Fibonacci hashing, scatters sequential IDs across the whole table
+        return static_cast<size_t>(static_cast<uint64_t>(id) * 0x9E3779B97F4A7C15ull >> 32);
+    }
+
+    const Entry* Lookup(ObjectId id) const
+    {
+        if (Entries.empty())
+            return nullptr;
+
+        const auto mask = Entries.size() - 1;
+        for (auto i = Hash(id) & mask; ; i = (i + 1) & mask)
+        {
+            auto& entry = Entries[i];
+            if (!entry.IsUsed)
+                return nullptr;
+            if (entry.ID == id)
+                return &entry;
+        }
+    }
+
+    void Rehash(size_t capacity)
+    {
+        assert((capacity & (capacity - 1)) == 0);
+
+        vector<Entry> entries(capacity, Entry{ 0, T(), false });
+        entries.swap(Entries);
+        Count = 0;
+
+        for (auto& entry : entries)
+            if (entry.IsUsed)
+                Insert(entry.ID, entry.Value);
+    }
+
+    vector<Entry> Entries;
+    int           Count;
+};
+
+// Maps object ID to object regardless of its kind.
+struct ObjectIndex
+{
+    void    Clear()                             { Index.Clear(); }
+    void    Insert(ObjectId id, Object* object) { assert(object != nullptr); Index.Insert(id, object); }
+    void    Remove(ObjectId id)                 { Index.Remove(id); }
+
+    Object* Find(ObjectId id) const             { auto object = Index.Find(id); return object ? *object : nullptr; }
+    Object* Find(ObjectId id, ObjectType type) const;
+
+    int     Size() const                        { return Index.Size(); }
+
+private:
+    IdIndex<Object*> Index;
+};
+
+// Uniform grid over object bounds. Object is registered in every cell its
+// bounds overlap and is moved only when that range of cells changes.
+// Objects covering too many cells are kept aside and always reported.
+// T has to provide GridCells and GridQueryMark fields.
+template <typename T>
+struct ObjectGrid
+{
+    ObjectGrid(): QueryMark(0) {}
+
+    void Update(T* object, const rectf& bounds)
+    {
+        const auto  cells   = CellRange(bounds);
+        const auto& current = object->GridCells;
+        if (cells.x == current.x && cells.y == current.y && cells.w == current.w && cells.h == current.h)
+            return;
+
+        Remove(object);
+
+        if (IsOversized(cells))
+            Oversized.push_back(object);
+        else
+        {
+            for (auto y = cells.top(); y < cells.bottom(); ++y)
+                for (auto x = cells.left(); x < cells.right(); ++x)
+                    Cells[CellKey(x, y)].push_back(object);
+        }
+
+        object->GridCells = cells;
+    }
+
+    void Remove(T* object)
+    {
+        const auto cells = object->GridCells;
+        if (cells.is_empty())
+            return;
+
+        if (IsOversized(cells))
+            Erase(Oversized, object);
+        else
+        {
+            for (auto y = cells.top(); y < cells.bottom(); ++y)
+            {
+                for (auto x = cells.left(); x < cells.right(); ++x)
+                {
+                    auto cellIt = Cells.find(CellKey(x, y));
+                    if (cellIt == Cells.end())
+                        continue;
+
+                    Erase(cellIt->second, object);
+                    if (cellIt->second.empty())
+                        Cells.erase(cellIt);
+                }
+            }
+        }
+
+        object->GridCells = rect();
+    }
+
+    // Appends objects registered in cells overlapping rect, each one once.
+    // Bounds of reported objects still have to be tested by the caller.
+    void Query(const rectf& r, vector<T*>& result)
+    {
+        const auto mark = ++QueryMark;
+
+        auto report = [&result, mark](T* object)
+        {
+            if (object->GridQueryMark == mark)
+                return;
+
+            object->GridQueryMark = mark;
+            result.push_back(object);
+        };
+
+        for (auto object : Oversized)
+            report(object);
+
+        const auto cells = CellRange(r);
+
+        // When zoomed far out visiting occupied cells is cheaper than visiting
+        // every cell in range.
+        if (static_cast<size_t>(cells.w) * static_cast<size_t>(cells.h) > Cells.size())
+        {
+            for (auto& cell : Cells)
+            {
+                const auto x = static_cast<int>(static_cast<uint32_t>(cell.first >> 32));
+                const auto y = static_cast<int>(static_cast<uint32_t>(cell.first));
+                if (x < cells.left() || x >= cells.right() || y < cells.top() || y >= cells.bottom())
+                    continue;
+
+                for (auto object : cell.second)
+                    report(object);
+            }
+        }
+        else
+        {
+            for (auto y = cells.top(); y < cells.bottom(); ++y)
+            {
+                for (auto x = cells.left(); x < cells.right(); ++x)
+                {
+                    auto cellIt = Cells.find(CellKey(x, y));
+                    if (cellIt == Cells.end())
+                        continue;
+
+                    for (auto object : cellIt->second)
+                        report(object);
+                }
+            }
+        }
+    }
+
+private:
+    static const int c_CellSize        = 256; // In canvas units
+    static const int c_MaxCellsPerObject = 64;
+
+    static uint64_t CellKey(int x, int y) { return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y); }
+    static bool     IsOversized(const rect& cells) { return cells.w * cells.h > c_MaxCellsPerObject; }
+
+    static rect CellRange(const rectf& bounds)
+    {
+        const auto x0 = static_cast<int>(floorf(bounds.left()   / c_CellSize));
+        const auto y0 = static_cast<int>(floorf(bounds.top()    / c_CellSize));
+        const auto x1 = static_cast<int>(floorf(bounds.right()  / c_CellSize));
+        const auto y1 = static_cast<int>(floorf(bounds.bottom() / c_CellSize));
+
+        return rect(x0, y0, x1 - x0 + 1, y1 - y0 + 1);
+    }
+
+    static void Erase(vector<T*>& objects, T* object)
+    {
+        auto it = std::find(objects.begin(), objects.end(), object);
+        if (it != objects.end())
+        {
+            *it = objects.back();
+            objects.pop_back();
+        }
+    }
+
+    std::unordered_map<uint64_t, vector<T*>> Cells;
+    vector<T*>                               Oversized;
+    int                                      QueryMark;
+};
+
+// Per-frame state of one kind of objects in structure of arrays layout:
+// bounds, last live frame and owning object per slot. Bounds are tested
+// against visible area in a single pass per frame, visible live objects
+// are kept as a bitset and as a list to draw from.
+// Object owns a slot from Add() until Remove().
+struct VisibilitySet
+{
+    VisibilitySet(): Count(0) {}
+
+    int  Add(Object* object, const rectf& bounds);
+    void Update(int slot, const rectf& bounds);
+    void Remove(int slot);
+
+    void MarkLive(int slot, int frameIndex) { LiveFrames[slot] = frameIndex; }
+    int  CountLive(int frameIndex) const;
+
+    void Cull(const rectf& visibleBounds, int frameIndex);
+
+    bool IsVisible(int slot) const { return (Bits[slot >> 5] >> (slot & 31)) & 1; }
+
+    const vector<Object*>& GetVisibleObjects() const { return VisibleObjects; }
+
+private:
+    vector<float>    MinX, MinY, MaxX, MaxY; // Padded to multiple of 32
+    vector<int>      LiveFrames;
+    vector<Object*>  Objects;
+    vector<uint32_t> Bits;
+    vector<Object*>  VisibleObjects;
+    vector<int>      FreeSlots;
+    int              Count;
+};
+
+// Range of primitives node recorded into one of node layer channels.
+// Channels are shared by all nodes, segments are put in node drawing
+// order once per frame.
+struct NodeDrawSegment
+{
+    Node* Node;
+    int   Layer;
+    int   IdxBegin;    // Index range in layer channel, end is
+    int   IdxEnd;      // resolved at the end of frame
+    int   CmdBegin;    // First command overlapping the range
+    int   CmdIdxStart; // and index it starts at
+
+    NodeDrawSegment(Detail::Node* node, int layer, int idxBegin):
+        Node(node), Layer(layer), IdxBegin(idxBegin), IdxEnd(idxBegin), CmdBegin(0), CmdIdxStart(0) {}
+};
+
+enum class NodeType
+{
+    Node,
+    Group
+};
+
+// Allocates objects of a single type from fixed size slabs. Address of
+// an object is stable for its lifetime and released slots are reused
+// before new slab is allocated.
+template <typename T, int SlabSize = 256>
+struct ObjectPool
+{
+    ObjectPool(): FreeList(nullptr) {}
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+    ~ObjectPool()
+    {
+        for (auto slab : Slabs)
+            delete[] slab;
+    }
+
+    template <typename... Args>
+    T* Create(Args&&... args)
+    {
+        if (!FreeList)
+            Grow();
+
+        auto slot = FreeList;
+        FreeList = slot->Next;
+
+        return new (&slot->Storage) T(std::forward<Args>(args)...);
+    }
+
+    void Destroy(T* object)
+    {
+        object->~T();
+
+        auto slot = reinterpret_cast<Slot*>(object);
+        slot->Next = FreeList;
+        FreeList   = slot;
+    }
+
+private:
+    union Slot
+    {
+        Slot* Next;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type Storage;
+    };
+
+    void Grow()
+    {
+        auto slab = new Slot[SlabSize];
+        for (int i = SlabSize - 1; i >= 0; --i)
+        {
+            slab[i].Next = FreeList;
+            FreeList     = &slab[i];
+        }
+        Slabs.push_back(slab);
+    }
+
+    vector<Slot*> Slabs;
+    Slot*         FreeList;
+};
+
 struct Object
 {
     enum DrawFlags
@@ -90,24 +484,25 @@ struct Object
     inline friend DrawFlags& operator&=(DrawFlags& lhs, DrawFlags rhs) { lhs = lhs & rhs; return lhs; }
 
     EditorContext* const Editor;
+    const ObjectType     TypeTag; // Lets hot loops classify objects without virtual calls
 
-    int     ID;
-    bool    IsLive;
-
-    Object(EditorContext* editor, int id): Editor(editor), ID(id), IsLive(true) {}
-    virtual ~Object() = default;
+    ObjectId ID;
+    int      LiveFrame;      // Last frame object was submitted in, live when it is the current one
+    int      CreationFrame;
+    int      VisibilitySlot; // Slot in visibility set of object kind, -1 if none
 
-    bool IsVisible() const
+    Object(EditorContext* editor, ObjectType typeTag, ObjectId id):
+        Editor(editor), TypeTag(typeTag), ID(id), LiveFrame(-1), CreationFrame(-1), VisibilitySlot(-1)
     {
-        if (!IsLive)
-            return false;
+    }
+    virtual ~Object() = default;
 
-        const auto bounds = GetBounds();
+    inline bool IsLive() const;
+    inline void MarkLive();
 
-        return ImGui::IsRectVisible(to_imvec(bounds.top_left()), to_imvec(bounds.bottom_right()));
-    }
+    inline bool IsVisible() const;
 
-    virtual void Reset() { IsLive = false; }
+    void Reset() { LiveFrame = -1; }
 
     virtual void Draw(ImDrawList* drawList, DrawFlags flags = None) = 0;
 
@@ -121,7 +516,7 @@ struct Object
 
     virtual bool TestHit(const ImVec2& point, float extraThickness = 0.0f) const
     {
-        if (!IsLive)
+        if (!IsLive())
             return false;
 
         auto bounds = GetBounds();
@@ -133,7 +528,7 @@ struct Object
 
     virtual bool TestHit(const ax::rectf& rect, bool allowIntersect = true) const
     {
-        if (!IsLive)
+        if (!IsLive())
             return false;
 
         const auto bounds = GetBounds();
@@ -142,9 +537,13 @@ struct Object
 
     virtual ax::rectf GetBounds() const = 0;
 
-    virtual Node*  AsNode()  { return nullptr; }
-    virtual Pin*   AsPin()   { return nullptr; }
-    virtual Link*  AsLink()  { return nullptr; }
+    bool IsNode() const { return TypeTag == ObjectType::Node; }
+    bool IsPin()  const { return TypeTag == ObjectType::Pin;  }
+    bool IsLink() const { return TypeTag == ObjectType::Link; }
+
+    inline Node*  AsNode();
+    inline Pin*   AsPin();
+    inline Link*  AsLink();
 };
 
 struct Pin final: Object
@@ -164,68 +563,85 @@ struct Pin final: Object
     float   Radius;
     float   ArrowSize;
     float   ArrowWidth;
-    bool    HasConnection;
-    bool    HadConnection;
+    int     ConnectionFrame;
+    int     Version;
 
-    Pin(EditorContext* editor, int id, PinKind kind):
-        Object(editor, id), Kind(kind), Node(nullptr), Bounds(), PreviousPin(nullptr),
+    vector<Link*> Links; // Links attached to pin, ones not submitted in previous
+                         // frame are detached when pin is submitted
+
+    Pin(EditorContext* editor, ObjectId id, PinKind kind):
+        Object(editor, ObjectType::Pin, id), Kind(kind), Node(nullptr), Bounds(), PreviousPin(nullptr),
         Color(IM_COL32_WHITE), BorderColor(IM_COL32_BLACK), BorderWidth(0), Rounding(0),
         Corners(0), Dir(0, 0), Strength(0), Radius(0), ArrowSize(0), ArrowWidth(0),
-        HasConnection(false), HadConnection(false)
+        ConnectionFrame(-1), Version(0)
     {
     }
 
-    virtual void Reset() override final
-    {
-        HadConnection = HasConnection && IsLive;
-        HasConnection = false;
-
-        __super::Reset();
-    }
-
     virtual void Draw(ImDrawList* drawList, DrawFlags flags = None) override final;
 
     ImVec2 GetClosestPoint(const ImVec2& p) const;
     line_f GetClosestLine(const Pin* pin) const;
 
-    virtual ax::rectf GetBounds() const override final { return static_cast<rectf>(Bounds); }
-
-    virtual Pin* AsPin() override final { return this; }
-};
+    void AttachLink(Link* link) { Links.push_back(link); }
+    void DetachLink(Link* link)
+    {
+        auto it = std::find(Links.begin(), Links.end(), link);
+        if (it != Links.end())
+        {
+            *it = Links.back();
+            Links.pop_back();
+        }
+    }
+    void DetachDeadLinks();
 
-enum class NodeType
-{
-    Node,
-    Group
+    virtual ax::rectf GetBounds() const override final { return static_cast<rectf>(Bounds); }
 };
 
 struct Node final: Object
 {
-    NodeType Type;
-    rect     Bounds;
-    int      Channel;
-    Pin*     LastPin;
-    point    DragStart;
-
-    ImU32    Color;
-    ImU32    BorderColor;
-    float    BorderWidth;
-    float    Rounding;
-
-    ImU32    GroupColor;
-    ImU32    GroupBorderColor;
-    float    GroupBorderWidth;
-    float    GroupRounding;
-    rect     GroupBounds;
-
-    bool     RestoreState;
-    bool     CenterOnScreen;
-
-    Node(EditorContext* editor, int id):
-        Object(editor, id),
+    NodeType  Type;
+    rect      Bounds;
+    int       DrawOrder; // Position of node in merged draw list, -1 if not drawn
+    Pin*      LastPin;
+    point     DragStart;
+
+    ImU32     Color;
+    ImU32     BorderColor;
+    float     BorderWidth;
+    float     Rounding;
+
+    ImU32     GroupColor;
+    ImU32     GroupBorderColor;
+    float     GroupBorderWidth;
+    float     GroupRounding;
+    rect      GroupBounds;
+
+    bool      RestoreState;
+    bool      CenterOnScreen;
+
+    int       ZOrder;        // Drawing order, groups are always below regular nodes
+    Node*     PrevInZOrder;  // Neighbours in order of regular nodes
+    Node*     NextInZOrder;
+    int       GroupArea;     // Area group is ordered by, -1 for regular node
+    bool      IsZOrderDirty; // Queued for change of group order
+    rect      GridCells;     // Cells of ObjectGrid node is registered in, empty if none
+    int       GridQueryMark;
+
+    rect      SceneBounds;       // Bounds, group bounds and type as last
+    rect      SceneGroupBounds;  // reported to EditorContext
+    NodeType  SceneType;
+
+    Node*         GroupParent;         // Smallest group containing node
+    vector<Node*> GroupChildren;       // Nodes with this one as GroupParent
+    bool          IsGroupParentDirty;  // Queued for update of GroupParent
+    bool          IsGroupContentDirty; // or GroupChildren in EditorContext
+    bool          IsGroupLive;         // Set when group is submitted, cleared when frame ends without it
+
+    Node(EditorContext* editor, ObjectId id):
+        Object(editor, ObjectType::Node, id),
         Type(NodeType::Node),
         Bounds(),
-        Channel(0),
+        DrawOrder(-1),
         LastPin(nullptr),
         DragStart(),
         Color(IM_COL32_WHITE),
@@ -234,7 +650,22 @@ struct Node final: Object
         Rounding(0),
         GroupBounds(),
         RestoreState(false),
-        CenterOnScreen(false)
+        CenterOnScreen(false),
+        ZOrder(0),
+        PrevInZOrder(nullptr),
+        NextInZOrder(nullptr),
+        GroupArea(-1),
+        IsZOrderDirty(false),
+        GridCells(),
+        GridQueryMark(0),
+        SceneBounds(),
+        SceneGroupBounds(),
+        SceneType(NodeType::Node),
+        GroupParent(nullptr),
+        GroupChildren(),
+        IsGroupParentDirty(false),
+        IsGroupContentDirty(false),
+        IsGroupLive(false)
     {
     }
 
@@ -253,8 +684,6 @@ struct Node final: Object
     void CenterOnScreenInNextFrame() { CenterOnScreen = true; }
 
     virtual ax::rectf GetBounds() const override final { return static_cast<rectf>(Bounds); }
-
-    virtual Node* AsNode() override final { return this; }
 };
 
 struct Link final: Object
@@ -265,9 +694,20 @@ struct Link final: Object
     float  Thickness;
     ImVec2 Start;
     ImVec2 End;
+    int    StartPinVersion; // Pin versions Start and End were computed for
+    int    EndPinVersion;
+    bool   IsAttached;      // Link is in Links of its pins
+
+    cubic_bezier_t         Curve;    // Geometry derived from endpoints and pins,
+    rectf                  Bounds;   // refreshed by UpdateGeometry()
+    mutable vector<pointf> Polyline; // Flattened curve, built on first use
 
-    Link(EditorContext* editor, int id):
-        Object(editor, id), StartPin(nullptr), EndPin(nullptr), Color(IM_COL32_WHITE), Thickness(1.0f)
+    rect   GridCells;     // Cells of ObjectGrid link is registered in, empty if none
+    int    GridQueryMark;
+
+    Link(EditorContext* editor, ObjectId id):
+        Object(editor, ObjectType::Link, id), StartPin(nullptr), EndPin(nullptr), Color(IM_COL32_WHITE), Thickness(1.0f),
+        StartPinVersion(-1), EndPinVersion(-1), IsAttached(false), Curve(), Bounds(), GridCells(), GridQueryMark(0)
     {
     }
 
@@ -276,31 +716,37 @@ struct Link final: Object
     virtual void Draw(ImDrawList* drawList, DrawFlags flags = None) override final;
     void Draw(ImDrawList* drawList, ImU32 color, float extraThickness = 0.0f) const;
 
+    void AttachPins(Pin* startPin, Pin* endPin);
+    void DetachPins();
     void UpdateEndpoints();
+    void UpdateGeometry();
 
-    cubic_bezier_t GetCurve() const;
+    const cubic_bezier_t& GetCurve() const { return Curve; }
+    const vector<pointf>& GetPolyline() const;
 
     virtual bool TestHit(const ImVec2& point, float extraThickness = 0.0f) const override final;
     virtual bool TestHit(const ax::rectf& rect, bool allowIntersect = true) const override final;
 
     virtual ax::rectf GetBounds() const override final;
-
-    virtual Link* AsLink() override final { return this; }
 };
 
+inline Node* Object::AsNode() { return IsNode() ? static_cast<Node*>(this) : nullptr; }
+inline Pin*  Object::AsPin()  { return IsPin()  ? static_cast<Pin*>(this)  : nullptr; }
+inline Link* Object::AsLink() { return IsLink() ? static_cast<Link*>(this) : nullptr; }
+
 struct NodeSettings
 {
-    int    ID;
-    ImVec2 Location;
-    ImVec2 Size;
-    ImVec2 GroupSize;
-    bool   WasUsed;
+    ObjectId ID;
+    ImVec2   Location;
+    ImVec2   Size;
+    ImVec2   GroupSize;
+    bool     WasUsed;
 
     bool            Saved;
     bool            IsDirty;
     SaveReasonFlags DirtyReason;
 
-    NodeSettings(int id): ID(id), Location(0, 0), Size(0, 0), GroupSize(0, 0), WasUsed(false), Saved(false), IsDirty(false), DirtyReason(SaveReasonFlags::None) {}
+    NodeSettings(ObjectId id): ID(id), Location(0, 0), Size(0, 0), GroupSize(0, 0), WasUsed(false), Saved(false), IsDirty(false), DirtyReason(SaveReasonFlags::None) {}
 
     void ClearDirty();
     void MakeDirty(SaveReasonFlags reason);
@@ -317,15 +763,19 @@ struct Settings
     bool                 IsDirty;
     SaveReasonFlags      DirtyReason;
 
-    vector<NodeSettings> Nodes;
-    vector<int>          Selection;
+    vector<NodeSettings> Nodes;     // Dense, in order nodes were added
+    IdIndex<int>         NodeIndex; // Positions in Nodes by node ID
+    vector<ObjectId>     Selection;
     ImVec2               ViewScroll;
     float                ViewZoom;
 
     Settings(): IsDirty(false), DirtyReason(SaveReasonFlags::None), ViewScroll(0, 0), ViewZoom(1.0f) {}
 
-    NodeSettings* AddNode(int id);
-    NodeSettings* FindNode(int id);
+    NodeSettings* AddNode(ObjectId id);
+    NodeSettings* FindNode(ObjectId id);
+
+    // Has to be called after Nodes are modified directly.
+    void RebuildNodeIndex();
 
     void ClearDirty(Node* node = nullptr);
     void MakeDirty(SaveReasonFlags reason, Node* node = nullptr);
@@ -568,6 +1018,8 @@ struct FlowAnimationController final : AnimationController
 
     void Release(FlowAnimation* animation);
 
+    void Forget(Link* link);
+
 private:
     FlowAnimation* GetOrCreate(Link* link);
 
@@ -646,6 +1098,8 @@ struct NavigateAction final: EditorAction
 
     void SetWindow(ImVec2 position, ImVec2 size);
 
+    void Forget(Object* object);
+
     Canvas GetCanvas(bool alignToPixels = true);
 
 private:
@@ -739,7 +1193,7 @@ struct SelectAction final: EditorAction
     ImVec2          StartPoint;
     ImVec2          EndPoint;
     vector<Object*> CandidateObjects;
-    vector<Object*> SelectedObjectsAtStart;
+    vector<Object*> SelectedObjectsAtStart; // Sorted
 
     Animation       Animation;
 
@@ -757,15 +1211,25 @@ struct SelectAction final: EditorAction
     virtual SelectAction* AsSelect() override final { return this; }
 
     void Draw(ImDrawList* drawList);
+
+private:
+    bool AcceptsCandidate(Object* object, const ax::rectf& rect) const;
+    void SetCandidate(Object* object, bool isCandidate);
+    void RebuildCandidates(const ax::rectf& rect);
+    void UpdateCandidates(const ax::rectf& rect);
+
+    std::unordered_map<Object*, size_t> CandidateIndex; // Position in CandidateObjects
+    ax::rectf       CandidateRect;         // Rectangle and scene version
+    unsigned        CandidateSceneVersion; // CandidateObjects are valid for
 };
 
 struct ContextMenuAction final: EditorAction
 {
     enum Menu { None, Node, Pin, Link, Background };
 
-    Menu CandidateMenu;
-    Menu CurrentMenu;
-    int  ContextId;
+    Menu     CandidateMenu;
+    Menu     CurrentMenu;
+    ObjectId ContextId;
 
     ContextMenuAction(EditorContext* editor);
 
@@ -779,9 +1243,9 @@ struct ContextMenuAction final: EditorAction
 
     virtual ContextMenuAction* AsContextMenu() override final { return this; }
 
-    bool ShowNodeContextMenu(int* nodeId);
-    bool ShowPinContextMenu(int* pinId);
-    bool ShowLinkContextMenu(int* linkId);
+    bool ShowNodeContextMenu(ObjectId* nodeId);
+    bool ShowPinContextMenu(ObjectId* pinId);
+    bool ShowLinkContextMenu(ObjectId* linkId);
     bool ShowBackgroundContextMenu();
 };
 
@@ -882,8 +1346,8 @@ struct CreateItemAction final : EditorAction
     Result RejectItem();
     Result AcceptItem();
 
-    Result QueryLink(int* startId, int* endId);
-    Result QueryNode(int* pinId);
+    Result QueryLink(ObjectId* startId, ObjectId* endId);
+    Result QueryNode(ObjectId* pinId);
 
 private:
     bool IsInGlobalSpace;
@@ -916,8 +1380,8 @@ struct DeleteItemsAction final: EditorAction
     bool Begin();
     void End();
 
-    bool QueryLink(int* linkId, int* startId = nullptr, int* endId = nullptr);
-    bool QueryNode(int* nodeId);
+    bool QueryLink(ObjectId* linkId, ObjectId* startId = nullptr, ObjectId* endId = nullptr);
+    bool QueryNode(ObjectId* nodeId);
 
     bool AcceptItem();
     void RejectItem();
@@ -926,7 +1390,7 @@ private:
     enum IteratorType { Unknown, Link, Node };
     enum UserAction { Undetermined, Accepted, Rejected };
 
-    bool QueryItem(int* itemId, IteratorType itemType);
+    bool QueryItem(ObjectId* itemId, IteratorType itemType);
     void RemoveItem();
 
     vector<Object*> ManuallyDeletedObjects;
@@ -952,16 +1416,22 @@ struct NodeBuilder
     ImVec2 PivotScale;
     bool   ResolvePinRect;
     bool   ResolvePivot;
+    rectf  LastPivot;     // Pin geometry from previous frame, used to
+    float  LastRadius;    // tell if links of pin have to be updated
+    float  LastArrowSize;
+    ImVec2 LastDir;
+    float  LastStrength;
+    rect   LastBounds;
 
     rect   GroupBounds;
     bool   IsGroup;
 
     NodeBuilder(EditorContext* editor);
 
-    void Begin(int nodeId);
+    void Begin(ObjectId nodeId);
     void End();
 
-    void BeginPin(int pinId, PinKind kind);
+    void BeginPin(ObjectId pinId, PinKind kind);
     void EndPin();
 
     void PinRect(const ImVec2& a, const ImVec2& b);
@@ -984,7 +1454,7 @@ struct HintBuilder
 
     HintBuilder(EditorContext* editor);
 
-    bool Begin(int nodeId);
+    bool Begin(ObjectId nodeId);
     void End();
 
     ImVec2 GetGroupMin();
@@ -1032,11 +1502,11 @@ struct Config: ax::NodeEditor::Config
     Config(const ax::NodeEditor::Config* config);
 
     std::string Load();
-    std::string LoadNode(int nodeId);
+    std::string LoadNode(ObjectId nodeId);
 
     void BeginSave();
     bool Save(const std::string& data, SaveReasonFlags flags);
-    bool SaveNode(int nodeId, const std::string& data, SaveReasonFlags flags);
+    bool SaveNode(ObjectId nodeId, const std::string& data, SaveReasonFlags flags);
     void EndSave();
 };
 
@@ -1050,7 +1520,7 @@ struct EditorContext
     void Begin(const char* id, const ImVec2& size = ImVec2(0, 0));
     void End();
 
-    bool DoLink(int id, int startPinId, int endPinId, ImU32 color, float thickness);
+    bool DoLink(ObjectId id, ObjectId startPinId, ObjectId endPinId, ImU32 color, float thickness);
 
     NodeBuilder& GetNodeBuilder() { return NodeBuilder; }
     HintBuilder& GetHintBuilder() { return HintBuilder; }
@@ -1064,9 +1534,9 @@ struct EditorContext
 
     const Canvas& GetCanvas() const { return Canvas; }
 
-    void SetNodePosition(int nodeId, const ImVec2& screenPosition);
-    ImVec2 GetNodePosition(int nodeId);
-    ImVec2 GetNodeSize(int nodeId);
+    void SetNodePosition(ObjectId nodeId, const ImVec2& screenPosition);
+    ImVec2 GetNodePosition(ObjectId nodeId);
+    ImVec2 GetNodeSize(ObjectId nodeId);
 
     void MarkNodeToRestoreState(Node* node);
     void RestoreNodeState(Node* node);
@@ -1083,13 +1553,29 @@ struct EditorContext
     bool HasSelectionChanged();
     uint64_t GetSelectionId() const { return SelectionId; }
 
+    void NotifyNodeBoundsChanged(Node* node);
+    void NotifyGroupSubmitted(Node* group);
+    void NotifySceneChanged() { ++SceneVersion; }
+    void NotifyObjectLive(Object* object, bool wasLive)
+    {
+        ++LiveObjectCount;
+        if (!wasLive)
+            ++SceneVersion;
+        if (object->VisibilitySlot >= 0)
+            GetVisibility(object->TypeTag).MarkLive(object->VisibilitySlot, FrameIndex);
+    }
+
     Node* FindNodeAt(const ImVec2& p);
     void FindNodesInRect(const ax::rectf& r, vector<Node*>& result, bool append = false, bool includeIntersecting = true);
     void FindLinksInRect(const ax::rectf& r, vector<Link*>& result, bool append = false);
 
-    void FindLinksForNode(int nodeId, vector<Link*>& result, bool add = false);
+    void FindGroupChildren(ObjectId nodeId, vector<Node*>& result, bool add = false);
+    void UpdateGroupHierarchy();
 
-    bool PinHadAnyLinks(int pinId);
+    void FindLinksForNode(ObjectId nodeId, vector<Link*>& result, bool add = false);
+    void FindLinksForPin(ObjectId pinId, vector<Link*>& result, bool add = false);
+
+    bool PinHadAnyLinks(ObjectId pinId);
 
     ImVec2 ToCanvas(ImVec2 point) { return Canvas.FromScreen(point); }
     ImVec2 ToScreen(ImVec2 point) { return Canvas.ToScreen(point); }
@@ -1100,33 +1586,45 @@ struct EditorContext
     void Resume();
     bool IsSuspended();
 
+    void LeaveCanvasSpace();
+    void EnterCanvasSpace();
+
     bool IsActive();
 
+    int GetFrameIndex() const { return FrameIndex; }
+    unsigned GetSceneVersion() const { return SceneVersion; }
+
+    bool IsVisible(ObjectType type, int visibilitySlot) const { return GetVisibility(type).IsVisible(visibilitySlot); }
+
+    void SetNodeDrawLayer(ImDrawList* drawList, Node* node, int layer);
+
     void MakeDirty(SaveReasonFlags reason);
     void MakeDirty(SaveReasonFlags reason, Node* node);
 
-    Pin*    CreatePin(int id, PinKind kind);
-    Node*   CreateNode(int id);
-    Link*   CreateLink(int id);
-    Object* FindObject(int id);
+    Pin*    CreatePin(ObjectId id, PinKind kind);
+    Node*   CreateNode(ObjectId id);
+    Link*   CreateLink(ObjectId id);
+    Object* FindObject(ObjectId id);
 
-    Node*  FindNode(int id);
-    Pin*   FindPin(int id);
-    Link*  FindLink(int id);
+    Node*  FindNode(ObjectId id);
+    Pin*   FindPin(ObjectId id);
+    Link*  FindLink(ObjectId id);
 
-    Node*  GetNode(int id);
-    Pin*   GetPin(int id, PinKind kind);
-    Link*  GetLink(int id);
+    Node*  GetNode(ObjectId id);
+    Pin*   GetPin(ObjectId id, PinKind kind);
+    Link*  GetLink(ObjectId id);
 
     Link* FindLinkAt(const point& p);
 
+    void MergeNewObjects();
+
     template <typename T>
     ax::rectf GetBounds(const std::vector<T*>& objects)
     {
         ax::rectf bounds;
 
         for (auto object : objects)
-            if (object->IsLive)
+            if (object->IsLive())
                 bounds = make_union(bounds, object->GetBounds());
 
         return bounds;
@@ -1138,7 +1636,7 @@ struct EditorContext
         ax::rectf bounds;
 
         for (auto object : objects)
-            if (object.Object->IsLive)
+            if (object.Object->IsLive())
                 bounds = make_union(bounds, object.Object->GetBounds());
 
         return bounds;
@@ -1162,9 +1660,9 @@ struct EditorContext
     void EnableShortcuts(bool enable);
     bool AreShortcutsEnabled();
 
-    int GetDoubleClickedNode()       const { return DoubleClickedNode;       }
-    int GetDoubleClickedPin()        const { return DoubleClickedPin;        }
-    int GetDoubleClickedLink()       const { return DoubleClickedLink;       }
+    ObjectId GetDoubleClickedNode()  const { return DoubleClickedNode;       }
+    ObjectId GetDoubleClickedPin()   const { return DoubleClickedPin;        }
+    ObjectId GetDoubleClickedLink()  const { return DoubleClickedLink;       }
     bool IsBackgroundClicked()       const { return BackgroundClicked;       }
     bool IsBackgroundDoubleClicked() const { return BackgroundDoubleClicked; }
 
@@ -1181,6 +1679,8 @@ private:
     void SaveSettings();
 
     Control BuildControl(bool allowOffscreen);
+    Object* PickObjectAt(const ImVec2& position);
+    rect    GetInteractiveArea(Object* object, const ImVec2& p);
 
     void ShowMetrics(const Control& control);
 
@@ -1189,16 +1689,59 @@ private:
 
     void UpdateAnimations();
 
+    void ReclaimDeadObjects();
+
+    void RaiseNode(Node* node);
+    void LinkNodeZOrder(Node* node);
+    void UnlinkNodeZOrder(Node* node);
+    void UpdateGroupZOrder();
+
+    void MergeNodeDrawLayers(ImDrawList* drawList);
+
+    void MarkGroupParentDirty(Node* node);
+    void MarkGroupContentDirty(Node* group);
+    void SetGroupParent(Node* node, Node* parent);
+    Node* FindGroupParent(Node* node);
+
+    VisibilitySet&       GetVisibility(ObjectType type)       { assert(type == ObjectType::Node || type == ObjectType::Link); return type == ObjectType::Node ? NodeVisibility : LinkVisibility; }
+    const VisibilitySet& GetVisibility(ObjectType type) const { assert(type == ObjectType::Node || type == ObjectType::Link); return type == ObjectType::Node ? NodeVisibility : LinkVisibility; }
+
     bool                IsFirstFrame;
     bool                IsWindowActive;
+    int                 FrameIndex;
 
     bool                ShortcutsEnabled;
 
     Style               Style;
 
+    ObjectPool<Node>            NodePool;
+    ObjectPool<Pin>             PinPool;
+    ObjectPool<Link>            LinkPool;
+
     vector<ObjectWrapper<Node>> Nodes;
     vector<ObjectWrapper<Pin>>  Pins;
     vector<ObjectWrapper<Link>> Links;
+    ObjectIndex                 ObjectIndex;
+    ObjectGrid<Node>            NodeGrid;
+    ObjectGrid<Link>            LinkGrid;
+    VisibilitySet               NodeVisibility;
+    VisibilitySet               LinkVisibility;
+    size_t                      SortedPinCount;  // Pins past this point were created in current frame
+    size_t                      SortedLinkCount; // and are not yet merged into sorted range
+    vector<Link*>               SubmittedLinks;     // Links in order of submission in current
+    vector<Link*>               LastSubmittedLinks; // and previous frame
+    vector<Node*>               SubmittedGroups;     // Groups submitted in current
+    vector<Node*>               LastSubmittedGroups; // and previous frame
+    vector<Node*>               DirtyGroupParents;  // Nodes to find group for
+    vector<Node*>               DirtyGroupContents; // Groups which area or liveness changed
+    vector<Node*>               ZOrderGroups;       // Groups from largest to smallest
+    Node*                       ZOrderBack;         // Regular nodes from back
+    Node*                       ZOrderFront;        // to front
+    int                         NextZOrder;
+    vector<Node*>               DirtyZOrder;        // Nodes to move in group order
+    vector<NodeDrawSegment>     NodeDrawSegments;   // Node primitives in order of recording
+    vector<NodeDrawSegment*>    SortedDrawSegments; // and in node drawing order
+    vector<int>                 DrawSegmentBuckets;
 
     vector<Object*>     SelectedObjects;
 
@@ -1207,6 +1750,15 @@ private:
     bool                SelectionChanged;
 
     Link*               LastActiveLink;
+    Object*             LastActiveObject; // Node or pin holding ImGui active item
+
+    unsigned            SceneVersion;         // Bumped on every change affecting picking
+    int                 LiveObjectCount;      // Objects marked live in current
+    int                 LastLiveObjectCount;  // and previous frame
+    unsigned            PickSceneVersion;     // Scene and mouse position
+    ImVec2              PickMousePos;         // of cached pick results
+    Object*             PickedObject;
+    Link*               PickedLink;
 
     vector<Animation*>  LiveAnimations;
     vector<Animation*>  LastLiveAnimations;
@@ -1218,6 +1770,8 @@ private:
     Canvas              Canvas;
 
     int                 SuspendCount;
+    int                 ScreenSpaceCount;   // Canvas transformation is applied while zero
+    int                 ScreenSpaceChannel; // Channel current when canvas space was left
 
     NodeBuilder         NodeBuilder;
     HintBuilder         HintBuilder;
@@ -1235,9 +1789,9 @@ private:
     vector<AnimationController*> AnimationControllers;
     FlowAnimationController      FlowAnimationController;
 
-    int                 DoubleClickedNode;
-    int                 DoubleClickedPin;
-    int                 DoubleClickedLink;
+    ObjectId            DoubleClickedNode;
+    ObjectId            DoubleClickedPin;
+    ObjectId            DoubleClickedLink;
     bool                BackgroundClicked;
     bool                BackgroundDoubleClicked;
 
@@ -1247,6 +1801,35 @@ private:
     Config              Config;
 };
 
+inline bool Object::IsLive() const
+{
+    return LiveFrame == Editor->GetFrameIndex();
+}
+
+inline bool Object::IsVisible() const
+{
+    if (!IsLive())
+        return false;
+
+    // Nodes and links are culled in EditorContext::End
+    if (VisibilitySlot >= 0)
+        return Editor->IsVisible(TypeTag, VisibilitySlot);
+
+    const auto bounds = GetBounds();
+
+    return ImGui::IsRectVisible(to_imvec(bounds.top_left()), to_imvec(bounds.bottom_right()));
+}
+
+inline void Object::MarkLive()
+{
+    const auto frameIndex = Editor->GetFrameIndex();
+    if (LiveFrame == frameIndex)
+        return;
+
+    Editor->NotifyObjectLive(this, LiveFrame == frameIndex - 1);
+    LiveFrame = frameIndex;
+}
+
 } // namespace Detail
 } // namespace Editor
 } // namespace ax
@@ -25,7 +25,7 @@ util::BlueprintNodeBuilder::BlueprintNodeBuilder(ImTextureID texture, int textur
 {
 }
 
-void util::BlueprintNodeBuilder::Begin(int id)
+void util::BlueprintNodeBuilder::Begin(ed::ObjectId id)
 {
     HasHeader  = false;
     HeaderRect = rect();
@@ -107,7 +107,7 @@ void util::BlueprintNodeBuilder::EndHeader()
     SetStage(Stage::Content);
 }
 
-void util::BlueprintNodeBuilder::Input(int id)
+void util::BlueprintNodeBuilder::Input(ed::ObjectId id)
 {
     if (CurrentStage == Stage::Begin)
         SetStage(Stage::Content);
@@ -139,7 +139,7 @@ void util::BlueprintNodeBuilder::Middle()
     SetStage(Stage::Middle);
 }
 
-void util::BlueprintNodeBuilder::Output(int id)
+void util::BlueprintNodeBuilder::Output(ed::ObjectId id)
 {
     if (CurrentStage == Stage::Begin)
         SetStage(Stage::Content);
@@ -292,7 +292,7 @@ bool util::BlueprintNodeBuilder::SetStage(Stage stage)
     return true;
 }
 
-void util::BlueprintNodeBuilder::Pin(int id, ed::PinKind kind)
+void util::BlueprintNodeBuilder::Pin(ed::ObjectId id, ed::PinKind kind)
 {
     ed::BeginPin(id, kind);
 }
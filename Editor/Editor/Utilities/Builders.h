@@ -26,18 +26,18 @@ struct BlueprintNodeBuilder
 {
     BlueprintNodeBuilder(ImTextureID texture = nullptr, int textureWidth = 0, int textureHeight = 0);
 
-    void Begin(int id);
+    void Begin(ObjectId id);
     void End();
 
     void Header(const ImVec4& color = ImVec4(1, 1, 1, 1));
     void EndHeader();
 
-    void Input(int id);
+    void Input(ObjectId id);
     void EndInput();
 
     void Middle();
 
-    void Output(int id);
+    void Output(ObjectId id);
     void EndOutput();
 
 
@@ -56,13 +56,13 @@ private:
 
     bool SetStage(Stage stage);
 
-    void Pin(int id, ax::NodeEditor::PinKind kind);
+    void Pin(ObjectId id, ax::NodeEditor::PinKind kind);
     void EndPin();
 
     ImTextureID HeaderTextureId;
     int         HeaderTextureWidth;
     int         HeaderTextureHeight;
-    int         CurrentNodeId;
+    ObjectId    CurrentNodeId;
     Stage       CurrentStage;
     ImU32       HeaderColor;
     rect        NodeRect;
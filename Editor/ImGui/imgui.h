@@ -115,6 +115,8 @@ struct ImMatrix
     IM_MATRIX_CLASS_EXTRA
 #endif
 
+    inline ImVec2 Transform(const ImVec2& p) const { return ImVec2(m00 * p.x + m10 * p.y + x, m01 * p.x + m11 * p.y + y); }
+
     static inline ImMatrix Combine(const ImMatrix& lhs, const ImMatrix& rhs)
     {
         return ImMatrix(
@@ -1255,8 +1257,7 @@ struct ImDrawChannel
 
 struct ImDrawTransformation
 {
-    unsigned int            VtxStartIdx;
-    ImMatrix                Transformation;
+    ImMatrix                LastTransformation;
     float                   LastInvTransformationScale;
     ImVec2                  LastHalfPixel;
 };
@@ -1286,6 +1287,7 @@ struct ImDrawList
     int                     _ChannelsCount;     // [Internal] number of active channels (1+)
     ImVector<ImDrawChannel> _Channels;          // [Internal] draw channels for columns API (not resized down so _ChannelsCount may be smaller than _Channels.Size)
     ImVector<ImDrawTransformation> _TransformationStack;
+    ImMatrix                _Transformation;    // [Internal] combined transformation, applied to vertices as they are written
     float                   _InvTransformationScale;
     ImVec2                  _HalfPixel;
 
@@ -1297,7 +1299,7 @@ struct ImDrawList
     IMGUI_API void  PushTextureID(const ImTextureID& texture_id);
     IMGUI_API void  PopTextureID();
 
-    IMGUI_API void  PushTransformation(const ImMatrix& transformation);
+    IMGUI_API void  PushTransformation(const ImMatrix& transformation, bool keep_stroke_width = true);  // Primitives and clip rects are transformed as they are added. With 'keep_stroke_width' line thickness and AA fringe stay in output units, otherwise they are transformed too.
     IMGUI_API void  PopTransformation();
 
     // Primitives
@@ -1348,9 +1350,11 @@ struct ImDrawList
     IMGUI_API void  PrimRect(const ImVec2& a, const ImVec2& b, ImU32 col);      // Axis aligned rectangle (composed of two triangles)
     IMGUI_API void  PrimRectUV(const ImVec2& a, const ImVec2& b, const ImVec2& uv_a, const ImVec2& uv_b, ImU32 col);
     IMGUI_API void  PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, const ImVec2& d, const ImVec2& uv_a, const ImVec2& uv_b, const ImVec2& uv_c, const ImVec2& uv_d, ImU32 col);
-    inline    void  PrimWriteVtx(const ImVec2& pos, const ImVec2& uv, ImU32 col){ _VtxWritePtr->pos = pos; _VtxWritePtr->uv = uv; _VtxWritePtr->col = col; _VtxWritePtr++; _VtxCurrentIdx++; }
+    inline    ImVec2 PrimTransform(const ImVec2& pos) const                    { return _TransformationStack.Size ? _Transformation.Transform(pos) : pos; }
+    inline    void  PrimWriteVtx(const ImVec2& pos, const ImVec2& uv, ImU32 col){ _VtxWritePtr->pos = PrimTransform(pos); _VtxWritePtr->uv = uv; _VtxWritePtr->col = col; _VtxWritePtr++; _VtxCurrentIdx++; }
     inline    void  PrimWriteIdx(ImDrawIdx idx)                                 { *_IdxWritePtr = idx; _IdxWritePtr++; }
     inline    void  PrimVtx(const ImVec2& pos, const ImVec2& uv, ImU32 col)     { PrimWriteIdx((ImDrawIdx)_VtxCurrentIdx); PrimWriteVtx(pos, uv, col); }
+    IMGUI_API ImVec4 GetCurrentClipRect() const;                               // Top of clip rect stack, transformed as stored in draw commands
     IMGUI_API void  UpdateClipRect();
     IMGUI_API void  UpdateTextureID();
     IMGUI_API void  PrimDistributeUV(ImDrawVert* start, ImDrawVert* end, const ImVec2& a, const ImVec2& b, const ImVec2& uv_a, const ImVec2& uv_b, bool clamp);
@@ -131,6 +131,7 @@ void ImDrawList::Clear()
     _ChannelsCurrent = 0;
     _ChannelsCount = 1;
     _TransformationStack.resize(0);
+    _Transformation = ImMatrix();
     _InvTransformationScale = 1.0f;
     _HalfPixel = ImVec2(0.5f, 0.5f);
     // NB: Do not clear channels so our allocations are re-used after the first frame.
@@ -160,9 +161,27 @@ void ImDrawList::ClearFreeMemory()
 }
 
 // Use macros because C++ is a terrible language, we want guaranteed inline, no code in header, and no overhead in Debug mode
-#define GetCurrentClipRect()    (_ClipRectStack.Size ? _ClipRectStack.Data[_ClipRectStack.Size-1]  : GNullClipRect)
 #define GetCurrentTextureId()   (_TextureIdStack.Size ? _TextureIdStack.Data[_TextureIdStack.Size-1] : NULL)
 
+ImVec4 ImDrawList::GetCurrentClipRect() const
+{
+    if (_ClipRectStack.Size == 0)
+        return GNullClipRect;
+
+    const ImVec4& clip_rect = _ClipRectStack.Data[_ClipRectStack.Size-1];
+    if (_TransformationStack.Size == 0)
+        return clip_rect;
+
+    // Bounds of transformed rectangle
+    const ImVec2 a = _Transformation.Transform(ImVec2(clip_rect.x, clip_rect.y));
+    const ImVec2 b = _Transformation.Transform(ImVec2(clip_rect.z, clip_rect.y));
+    const ImVec2 c = _Transformation.Transform(ImVec2(clip_rect.z, clip_rect.w));
+    const ImVec2 d = _Transformation.Transform(ImVec2(clip_rect.x, clip_rect.w));
+    return ImVec4(
+        ImMin(ImMin(a.x, b.x), ImMin(c.x, d.x)), ImMin(ImMin(a.y, b.y), ImMin(c.y, d.y)),
+        ImMax(ImMax(a.x, b.x), ImMax(c.x, d.x)), ImMax(ImMax(a.y, b.y), ImMax(c.y, d.y)));
+}
+
 void ImDrawList::AddDrawCmd()
 {
     ImDrawCmd draw_cmd;
@@ -220,14 +239,14 @@ void ImDrawList::UpdateTextureID()
     }
 
     // Try to merge with previous command if it matches, else use current command
+    const ImVec4 curr_clip_rect = GetCurrentClipRect();
     ImDrawCmd* prev_cmd = CmdBuffer.Size > 1 ? curr_cmd - 1 : NULL;
-    if (prev_cmd && prev_cmd->TextureId == curr_texture_id && memcmp(&prev_cmd->ClipRect, &GetCurrentClipRect(), sizeof(ImVec4)) == 0 && prev_cmd->UserCallback == NULL)
+    if (prev_cmd && prev_cmd->TextureId == curr_texture_id && memcmp(&prev_cmd->ClipRect, &curr_clip_rect, sizeof(ImVec4)) == 0 && prev_cmd->UserCallback == NULL)
         CmdBuffer.pop_back();
     else
         curr_cmd->TextureId = curr_texture_id;
 }
 
-#undef GetCurrentClipRect
 #undef GetCurrentTextureId
 
 // Render-level scissoring. This is passed down to your render function but not used for CPU-side coarse clipping. Prefer using higher-level ImGui::PushClipRect() to affect logic (hit-testing and widget culling)
@@ -275,56 +294,49 @@ void ImDrawList::PopTextureID()
     UpdateTextureID();
 }
 
-void ImDrawList::PushTransformation(const ImMatrix& transformation)
+void ImDrawList::PushTransformation(const ImMatrix& transformation, bool keep_stroke_width)
 {
     ImDrawTransformation tr;
-    tr.Transformation             = transformation;
-    tr.VtxStartIdx                = _VtxCurrentIdx;
+    tr.LastTransformation         = _Transformation;
     tr.LastInvTransformationScale = _InvTransformationScale;
     tr.LastHalfPixel              = _HalfPixel;
     _TransformationStack.push_back(tr);
 
-    const float scaleX = sqrtf(
-        transformation.m00 * transformation.m00 +
-        transformation.m01 * transformation.m01);
+    _Transformation = ImMatrix::Combine(_Transformation, transformation);
+
+    if (keep_stroke_width)
+    {
+        const float scaleX = sqrtf(
+            transformation.m00 * transformation.m00 +
+            transformation.m01 * transformation.m01);
 
-    const float scaleY = sqrtf(
-        transformation.m10 * transformation.m10 +
-        transformation.m11 * transformation.m11);
+        const float scaleY = sqrtf(
+            transformation.m10 * transformation.m10 +
+            transformation.m11 * transformation.m11);
 
-    const float scale = (scaleX + scaleY) * 0.5f;
+        const float scale = (scaleX + scaleY) * 0.5f;
 
-    const float invScale = scale > 0.0f ? (1.0f / scale) : 1.0f;
+        const float invScale = scale > 0.0f ? (1.0f / scale) : 1.0f;
 
-    _InvTransformationScale = _InvTransformationScale * invScale;
-    _HalfPixel              = _HalfPixel              * invScale;
+        _InvTransformationScale = _InvTransformationScale * invScale;
+        _HalfPixel              = _HalfPixel              * invScale;
+    }
+
+    UpdateClipRect();
 }
 
 void ImDrawList::PopTransformation()
 {
     IM_ASSERT(_TransformationStack.Size > 0);
     const ImDrawTransformation& tr = _TransformationStack.back();
-    if (tr.VtxStartIdx < _VtxCurrentIdx)
-    {
-        const ImMatrix& m = tr.Transformation;
-
-        ImDrawVert* const vertexBegin = VtxBuffer.Data + tr.VtxStartIdx;
-        ImDrawVert* const vertexEnd   = VtxBuffer.Data + _VtxCurrentIdx;
-
-        for (ImDrawVert* vertex = vertexBegin; vertex != vertexEnd; ++vertex)
-        {
-            const float x = vertex->pos.x;
-            const float y = vertex->pos.y;
-
-            vertex->pos.x = m.m00 * x + m.m10 * y + m.x;
-            vertex->pos.y = m.m01 * x + m.m11 * y + m.y;
-        }
-    }
 
+    _Transformation         = tr.LastTransformation;
     _InvTransformationScale = tr.LastInvTransformationScale;
     _HalfPixel              = tr.LastHalfPixel;
 
     _TransformationStack.pop_back();
+
+    UpdateClipRect();
 }
 
 
@@ -354,7 +366,7 @@ void ImDrawList::ChannelsSplit(int channels_count)
         if (_Channels[i].CmdBuffer.Size == 0)
         {
             ImDrawCmd draw_cmd;
-            draw_cmd.ClipRect = _ClipRectStack.back();
+            draw_cmd.ClipRect = GetCurrentClipRect();
             draw_cmd.TextureId = _TextureIdStack.back();
             _Channels[i].CmdBuffer.push_back(draw_cmd);
         }
@@ -422,17 +434,41 @@ void ImDrawList::PrimReserve(int idx_count, int vtx_count)
     _IdxWritePtr = IdxBuffer.Data + idx_buffer_size;
 }
 
+// Corners of axis aligned rectangle (a, b, c, d) transformed. Transformation without
+// rotation and shear keeps rectangle axis aligned, then only two corners are transformed.
+static inline void TransformRectCorners(const ImDrawList* draw_list, const ImVec2& a, const ImVec2& c, ImVec2* corners)
+{
+    const ImMatrix& m = draw_list->_Transformation;
+    if (draw_list->_TransformationStack.Size == 0 || (m.m01 == 0.0f && m.m10 == 0.0f))
+    {
+        const ImVec2 ta = draw_list->PrimTransform(a);
+        const ImVec2 tc = draw_list->PrimTransform(c);
+        corners[0] = ta;
+        corners[1] = ImVec2(tc.x, ta.y);
+        corners[2] = tc;
+        corners[3] = ImVec2(ta.x, tc.y);
+    }
+    else
+    {
+        corners[0] = m.Transform(a);
+        corners[1] = m.Transform(ImVec2(c.x, a.y));
+        corners[2] = m.Transform(c);
+        corners[3] = m.Transform(ImVec2(a.x, c.y));
+    }
+}
+
 // Fully unrolled with inline call to keep our debug builds decently fast.
 void ImDrawList::PrimRect(const ImVec2& a, const ImVec2& c, ImU32 col)
 {
-    ImVec2 b(c.x, a.y), d(a.x, c.y), uv(GImGui->FontTexUvWhitePixel);
+    ImVec2 p[4], uv(GImGui->FontTexUvWhitePixel);
+    TransformRectCorners(this, a, c, p);
     ImDrawIdx idx = (ImDrawIdx)_VtxCurrentIdx;
     _IdxWritePtr[0] = idx; _IdxWritePtr[1] = (ImDrawIdx)(idx+1); _IdxWritePtr[2] = (ImDrawIdx)(idx+2);
     _IdxWritePtr[3] = idx; _IdxWritePtr[4] = (ImDrawIdx)(idx+2); _IdxWritePtr[5] = (ImDrawIdx)(idx+3);
-    _VtxWritePtr[0].pos = a; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
-    _VtxWritePtr[1].pos = b; _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col;
-    _VtxWritePtr[2].pos = c; _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col;
-    _VtxWritePtr[3].pos = d; _VtxWritePtr[3].uv = uv; _VtxWritePtr[3].col = col;
+    _VtxWritePtr[0].pos = p[0]; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
+    _VtxWritePtr[1].pos = p[1]; _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col;
+    _VtxWritePtr[2].pos = p[2]; _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col;
+    _VtxWritePtr[3].pos = p[3]; _VtxWritePtr[3].uv = uv; _VtxWritePtr[3].col = col;
     _VtxWritePtr += 4;
     _VtxCurrentIdx += 4;
     _IdxWritePtr += 6;
@@ -440,14 +476,15 @@ void ImDrawList::PrimRect(const ImVec2& a, const ImVec2& c, ImU32 col)
 
 void ImDrawList::PrimRectUV(const ImVec2& a, const ImVec2& c, const ImVec2& uv_a, const ImVec2& uv_c, ImU32 col)
 {
-    ImVec2 b(c.x, a.y), d(a.x, c.y), uv_b(uv_c.x, uv_a.y), uv_d(uv_a.x, uv_c.y);
+    ImVec2 p[4], uv_b(uv_c.x, uv_a.y), uv_d(uv_a.x, uv_c.y);
+    TransformRectCorners(this, a, c, p);
     ImDrawIdx idx = (ImDrawIdx)_VtxCurrentIdx;
     _IdxWritePtr[0] = idx; _IdxWritePtr[1] = (ImDrawIdx)(idx+1); _IdxWritePtr[2] = (ImDrawIdx)(idx+2);
     _IdxWritePtr[3] = idx; _IdxWritePtr[4] = (ImDrawIdx)(idx+2); _IdxWritePtr[5] = (ImDrawIdx)(idx+3);
-    _VtxWritePtr[0].pos = a; _VtxWritePtr[0].uv = uv_a; _VtxWritePtr[0].col = col;
-    _VtxWritePtr[1].pos = b; _VtxWritePtr[1].uv = uv_b; _VtxWritePtr[1].col = col;
-    _VtxWritePtr[2].pos = c; _VtxWritePtr[2].uv = uv_c; _VtxWritePtr[2].col = col;
-    _VtxWritePtr[3].pos = d; _VtxWritePtr[3].uv = uv_d; _VtxWritePtr[3].col = col;
+    _VtxWritePtr[0].pos = p[0]; _VtxWritePtr[0].uv = uv_a; _VtxWritePtr[0].col = col;
+    _VtxWritePtr[1].pos = p[1]; _VtxWritePtr[1].uv = uv_b; _VtxWritePtr[1].col = col;
+    _VtxWritePtr[2].pos = p[2]; _VtxWritePtr[2].uv = uv_c; _VtxWritePtr[2].col = col;
+    _VtxWritePtr[3].pos = p[3]; _VtxWritePtr[3].uv = uv_d; _VtxWritePtr[3].col = col;
     _VtxWritePtr += 4;
     _VtxCurrentIdx += 4;
     _IdxWritePtr += 6;
@@ -458,10 +495,10 @@ void ImDrawList::PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, c
     ImDrawIdx idx = (ImDrawIdx)_VtxCurrentIdx;
     _IdxWritePtr[0] = idx; _IdxWritePtr[1] = (ImDrawIdx)(idx+1); _IdxWritePtr[2] = (ImDrawIdx)(idx+2);
     _IdxWritePtr[3] = idx; _IdxWritePtr[4] = (ImDrawIdx)(idx+2); _IdxWritePtr[5] = (ImDrawIdx)(idx+3);
-    _VtxWritePtr[0].pos = a; _VtxWritePtr[0].uv = uv_a; _VtxWritePtr[0].col = col;
-    _VtxWritePtr[1].pos = b; _VtxWritePtr[1].uv = uv_b; _VtxWritePtr[1].col = col;
-    _VtxWritePtr[2].pos = c; _VtxWritePtr[2].uv = uv_c; _VtxWritePtr[2].col = col;
-    _VtxWritePtr[3].pos = d; _VtxWritePtr[3].uv = uv_d; _VtxWritePtr[3].col = col;
+    _VtxWritePtr[0].pos = PrimTransform(a); _VtxWritePtr[0].uv = uv_a; _VtxWritePtr[0].col = col;
+    _VtxWritePtr[1].pos = PrimTransform(b); _VtxWritePtr[1].uv = uv_b; _VtxWritePtr[1].col = col;
+    _VtxWritePtr[2].pos = PrimTransform(c); _VtxWritePtr[2].uv = uv_c; _VtxWritePtr[2].col = col;
+    _VtxWritePtr[3].pos = PrimTransform(d); _VtxWritePtr[3].uv = uv_d; _VtxWritePtr[3].col = col;
     _VtxWritePtr += 4;
     _VtxCurrentIdx += 4;
     _IdxWritePtr += 6;
@@ -574,9 +611,9 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
             // Add vertexes
             for (int i = 0; i < points_count; i++)
             {
-                _VtxWritePtr[0].pos = points[i];          _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
-                _VtxWritePtr[1].pos = temp_points[i*2+0]; _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;
-                _VtxWritePtr[2].pos = temp_points[i*2+1]; _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col_trans;
+                _VtxWritePtr[0].pos = PrimTransform(points[i]);          _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
+                _VtxWritePtr[1].pos = PrimTransform(temp_points[i*2+0]); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;
+                _VtxWritePtr[2].pos = PrimTransform(temp_points[i*2+1]); _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col_trans;
                 _VtxWritePtr += 3;
             }
         }
@@ -633,10 +670,10 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
             // Add vertexes
             for (int i = 0; i < points_count; i++)
             {
-                _VtxWritePtr[0].pos = temp_points[i*4+0]; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col_trans;
-                _VtxWritePtr[1].pos = temp_points[i*4+1]; _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col;
-                _VtxWritePtr[2].pos = temp_points[i*4+2]; _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col;
-                _VtxWritePtr[3].pos = temp_points[i*4+3]; _VtxWritePtr[3].uv = uv; _VtxWritePtr[3].col = col_trans;
+                _VtxWritePtr[0].pos = PrimTransform(temp_points[i*4+0]); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col_trans;
+                _VtxWritePtr[1].pos = PrimTransform(temp_points[i*4+1]); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col;
+                _VtxWritePtr[2].pos = PrimTransform(temp_points[i*4+2]); _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col;
+                _VtxWritePtr[3].pos = PrimTransform(temp_points[i*4+3]); _VtxWritePtr[3].uv = uv; _VtxWritePtr[3].col = col_trans;
                 _VtxWritePtr += 4;
             }
         }
@@ -659,10 +696,10 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
 
             const float dx = diff.x * (thickness * 0.5f);
             const float dy = diff.y * (thickness * 0.5f);
-            _VtxWritePtr[0].pos.x = p1.x + dy; _VtxWritePtr[0].pos.y = p1.y - dx; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
-            _VtxWritePtr[1].pos.x = p2.x + dy; _VtxWritePtr[1].pos.y = p2.y - dx; _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col;
-            _VtxWritePtr[2].pos.x = p2.x - dy; _VtxWritePtr[2].pos.y = p2.y + dx; _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col;
-            _VtxWritePtr[3].pos.x = p1.x - dy; _VtxWritePtr[3].pos.y = p1.y + dx; _VtxWritePtr[3].uv = uv; _VtxWritePtr[3].col = col;
+            _VtxWritePtr[0].pos = PrimTransform(ImVec2(p1.x + dy, p1.y - dx)); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
+            _VtxWritePtr[1].pos = PrimTransform(ImVec2(p2.x + dy, p2.y - dx)); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col;
+            _VtxWritePtr[2].pos = PrimTransform(ImVec2(p2.x - dy, p2.y + dx)); _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col;
+            _VtxWritePtr[3].pos = PrimTransform(ImVec2(p1.x - dy, p1.y + dx)); _VtxWritePtr[3].uv = uv; _VtxWritePtr[3].col = col;
             _VtxWritePtr += 4;
 
             _IdxWritePtr[0] = (ImDrawIdx)(_VtxCurrentIdx); _IdxWritePtr[1] = (ImDrawIdx)(_VtxCurrentIdx+1); _IdxWritePtr[2] = (ImDrawIdx)(_VtxCurrentIdx+2);
@@ -725,8 +762,8 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
             dm *= AA_SIZE * 0.5f;
 
             // Add vertices
-            _VtxWritePtr[0].pos = (points[i1] - dm); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
-            _VtxWritePtr[1].pos = (points[i1] + dm); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
+            _VtxWritePtr[0].pos = PrimTransform(points[i1] - dm); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
+            _VtxWritePtr[1].pos = PrimTransform(points[i1] + dm); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
             _VtxWritePtr += 2;
 
             // Add indexes for fringes
@@ -744,7 +781,7 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
         PrimReserve(idx_count, vtx_count);
         for (int i = 0; i < vtx_count; i++)
         {
-            _VtxWritePtr[0].pos = points[i]; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
+            _VtxWritePtr[0].pos = PrimTransform(points[i]); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
             _VtxWritePtr++;
         }
         for (int i = 2; i < points_count; i++)
@@ -1053,7 +1090,8 @@ void ImDrawList::AddImage(ImTextureID user_texture_id, const ImVec2& a, const Im
         PathFill(col);
         size_t endIndex = VtxBuffer.size();
 
-        PrimDistributeUV(VtxBuffer.Data + startIndex, VtxBuffer.Data + endIndex, a, b, uv0, uv1, true);
+        // Vertices are already transformed, so are corners. Valid for axis aligned transformations only.
+        PrimDistributeUV(VtxBuffer.Data + startIndex, VtxBuffer.Data + endIndex, PrimTransform(a), PrimTransform(b), uv0, uv1, true);
     }
     else
     {
@@ -2121,6 +2159,9 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
     ImDrawVert* vtx_write = draw_list->_VtxWritePtr;
     ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
     unsigned int vtx_current_idx = draw_list->_VtxCurrentIdx;
+    const ImMatrix& transformation = draw_list->_Transformation;
+    const bool transformed = draw_list->_TransformationStack.Size > 0;
+    const bool transformed_axis_aligned = transformed && transformation.m01 == 0.0f && transformation.m10 == 0.0f;
 
     while (s < text_end)
     {
@@ -2232,6 +2273,13 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
                         }
                     }
 
+                    // Glyph stays axis aligned, transform two corners only
+                    if (transformed_axis_aligned)
+                    {
+                        x1 = transformation.m00 * x1 + transformation.x; y1 = transformation.m11 * y1 + transformation.y;
+                        x2 = transformation.m00 * x2 + transformation.x; y2 = transformation.m11 * y2 + transformation.y;
+                    }
+
                     // We are NOT calling PrimRectUV() here because non-inlined causes too much overhead in a debug build.
                     // Inlined here:
                     {
@@ -2241,6 +2289,13 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
                         vtx_write[1].pos.x = x2; vtx_write[1].pos.y = y1; vtx_write[1].col = col; vtx_write[1].uv.x = u2; vtx_write[1].uv.y = v1;
                         vtx_write[2].pos.x = x2; vtx_write[2].pos.y = y2; vtx_write[2].col = col; vtx_write[2].uv.x = u2; vtx_write[2].uv.y = v2;
                         vtx_write[3].pos.x = x1; vtx_write[3].pos.y = y2; vtx_write[3].col = col; vtx_write[3].uv.x = u1; vtx_write[3].uv.y = v2;
+                        if (transformed && !transformed_axis_aligned)
+                        {
+                            vtx_write[0].pos = transformation.Transform(vtx_write[0].pos);
+                            vtx_write[1].pos = transformation.Transform(vtx_write[1].pos);
+                            vtx_write[2].pos = transformation.Transform(vtx_write[2].pos);
+                            vtx_write[3].pos = transformation.Transform(vtx_write[3].pos);
+                        }
                         vtx_write += 4;
                         vtx_current_idx += 4;
                         idx_write += 6;